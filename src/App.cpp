@@ -1,7 +1,14 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <algorithm> // clamp, max, min
+#include <chrono>
+#include <cstddef>  // offsetof
+#include <cstdlib>  // abs
 #include <iostream>
+#include <random>
+#include <utility>  // move
 #include "App.h"
+#include "Trace.h"
 
 // ---------------- Helpers locales (no contaminan interfaz) ----------------
 namespace {
@@ -40,6 +47,23 @@ namespace {
         return p;
     }
 
+    // Colores RGBA de las instancias.
+    constexpr float FOOD_RGBA[4] = {1.0f, 0.3f, 0.3f, 1.0f};
+    constexpr float HEAD_RGBA[4] = {0.2f, 1.0f, 0.4f, 1.0f};
+    constexpr float BODY_RGBA[4] = {0.2f, 0.8f, 1.0f, 1.0f};
+
+    /// @brief Reloj monótono en ns: misma base para los plazos de la simulación y el render.
+    std::int64_t steadyNs() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// @brief Duerme hasta el instante steadyNs() dado.
+    void sleepUntilNs(std::int64_t ns) {
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(ns))));
+    }
+
     // @brief Matriz ortográfica column-major para viewport 2D.
     void makeOrtho(float l, float r, float b, float t, float out[16]) {
         for (int i = 0; i < 16; ++i) out[i] = 0.0f;
@@ -54,11 +78,15 @@ namespace {
 
 // ---------------- App ----------------
 
-App::App(int width, int height, const char* title) noexcept
-    : winW(width), winH(height), winTitle(title) {}
+App::App(int width, int height, const char* title, AppConfig cfg) noexcept
+    : winW(width), winH(height), winTitle(title), config(std::move(cfg)) {}
 
 App::~App() {
     // destruir en orden inverso
+    if (simThread.joinable()) {
+        simRunning.store(false, std::memory_order_release);
+        simThread.join();
+    }
     if (window) {
         glfwDestroyWindow(window);
         window = nullptr;
@@ -120,12 +148,20 @@ void App::configureBaseGLState() {
     logGLInfo();
     configureBaseGLState();
 
-    game = std::make_unique<Game>(30, 20);
+    game = std::make_unique<Game>(30, 20, std::random_device{}());
+    autopilot = std::make_unique<Autopilot>(game->cols(), game->rows());
+    if (config.cyclePilot) cyclePilot = std::make_unique<CyclePilot>(game->cols(), game->rows());
+    autopilotOn = config.autopilot;
+    if (!config.recordDir.empty()) recorder.begin(*game);
     initRenderer2D(game->cols(), game->rows());
 
-    lastTime = glfwGetTime();
-    acc = 0.0;
-    updateWindowTitle();
+    // Los tres huecos reservan memoria para un tablero lleno: publicar no asigna.
+    const int cols = game->cols(), rows = game->rows();
+    snapshots = std::make_unique<TripleBuffer<BoardSnapshot>>(
+        [cols, rows] { return BoardSnapshot::withCapacity(cols, rows); });
+    tickNs = steadyNs();
+    nextTickNs = tickNs + tickStepNs();
+    publishSnapshot();
     return true;
 }
 
@@ -137,110 +173,425 @@ void App::initRenderer2D(int gridW, int gridH) {
     };
     glGenVertexArrays(1, &vao);
     glGenBuffers(1, &vbo);
+    glGenBuffers(1, &instanceVbo);
     glBindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+
+    // Atributos por instancia: desplazamiento (vec2) y color (vec4), avanzan una vez por quad.
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(CellInstance), (void*)offsetof(CellInstance, x));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(CellInstance), (void*)offsetof(CellInstance, r));
+    glVertexAttribDivisor(2, 1);
     glBindVertexArray(0);
 
     // Shaders mínimos
     static const char* VS = R"(#version 330 core
     layout(location=0) in vec2 aPos;
+    layout(location=1) in vec2 aCell;  // traslación en coords de grilla (por instancia)
+    layout(location=2) in vec4 aColor; // color (por instancia)
     uniform mat4 uProj;
-    uniform vec2 uCell; // traslación en coords de grilla
+    out vec4 vColor;
     void main(){
-        vec2 world = aPos + uCell;
+        vec2 world = aPos + aCell;
+        vColor = aColor;
         gl_Position = uProj * vec4(world, 0.0, 1.0);
     })";
 
     static const char* FS = R"(#version 330 core
+    in vec4 vColor;
     out vec4 FragColor;
-    uniform vec4 uColor;
-    void main(){ FragColor = uColor; })";
+    void main(){ FragColor = vColor; })";
 
     prog = linkProg(VS, FS);
-    uProjLoc  = glGetUniformLocation(prog, "uProj");
-    uCellLoc  = glGetUniformLocation(prog, "uCell");
-    uColorLoc = glGetUniformLocation(prog, "uColor");
+    uProjLoc = glGetUniformLocation(prog, "uProj");
+
+    // Fondo: el mismo quad escalado a [0..C]x[0..R]; el color de cada celda se calcula por fragmento,
+    // así que el coste no depende de cols*rows. VAO propio: sin atributos por instancia.
+    glGenVertexArrays(1, &gridVao);
+    glBindVertexArray(gridVao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glBindVertexArray(0);
+
+    static const char* GRID_VS = R"(#version 330 core
+    layout(location=0) in vec2 aPos;
+    uniform mat4 uProj;
+    uniform vec2 uGridSize; // columnas, filas
+    out vec2 vGrid;         // coords de grilla continuas
+    void main(){
+        vGrid = aPos * uGridSize;
+        gl_Position = uProj * vec4(vGrid, 0.0, 1.0);
+    })";
+
+    static const char* GRID_FS = R"(#version 330 core
+    in vec2 vGrid;
+    out vec4 FragColor;
+    void main(){
+        ivec2 c = ivec2(floor(vGrid));
+        bool odd = ((c.x + c.y) & 1) != 0;
+        float a = odd ? 0.12 : 0.16;
+        float b = odd ? 0.18 : 0.22;
+        FragColor = vec4(0.10 + a, 0.15 + b, 0.20 + a, 1.0);
+    })";
+
+    gridProg = linkProg(GRID_VS, GRID_FS);
+    uGridProjLoc = glGetUniformLocation(gridProg, "uProj");
+    uGridSizeLoc = glGetUniformLocation(gridProg, "uGridSize");
 
     // Proyección: [0..C]x[0..R] a NDC. Y crece hacia abajo (conveniente para tu lógica).
     makeOrtho(0.0f, (float)gridW, (float)gridH, 0.0f, proj);
+
+    // Peor caso: comida + serpiente que llena el tablero.
+    instances.reserve(static_cast<std::size_t>(gridW) * gridH + 1);
 }
 
-void App::drawCell(float cx, float cy, float r, float g, float b, float a) const {
+void App::uploadSnapshot(const BoardSnapshot& snap) {
+    // Orden = orden de pintado: comida, cola interpolada y cuerpo de cola a cabeza (la cabeza encima).
+    instances.clear();
+    if (!snap.won) {
+        instances.push_back({(float)snap.food.x, (float)snap.food.y,
+                             FOOD_RGBA[0], FOOD_RGBA[1], FOOD_RGBA[2], FOOD_RGBA[3]});
+    }
+    ghostIdx = instances.size();
+    instances.push_back({(float)snap.prevTail.x, (float)snap.prevTail.y,
+                         BODY_RGBA[0], BODY_RGBA[1], BODY_RGBA[2], BODY_RGBA[3]});
+    headIdx = ghostIdx + snap.body.size();
+    for (std::size_t i = 0; i < snap.body.size(); ++i) {
+        const float* rgba = (i + 1 == snap.body.size()) ? HEAD_RGBA : BODY_RGBA;
+        const Cell& c = snap.body[i];
+        instances.push_back({(float)c.x, (float)c.y, rgba[0], rgba[1], rgba[2], rgba[3]});
+    }
+
+    // Orphaning: buffer nuevo para no esperar a que la GPU suelte el anterior.
+    const auto bytes = static_cast<GLsizeiptr>(instances.size() * sizeof(CellInstance));
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+}
+
+void App::interpolate(const BoardSnapshot& snap) {
+    // Fracción del tick en curso, medida desde el instante en que tocaba el último tick.
+    float alpha = snap.moved ? (float)((double)(steadyNs() - snap.tickNs) / (double)snap.tickIntervalNs) : 1.0f;
+    alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+
+    // Solo se interpola entre celdas vecinas: un salto de wrap se dibuja ya en destino.
+    const auto lerp = [alpha](const Cell& from, const Cell& to, CellInstance& out) {
+        const bool adjacent = std::abs(to.x - from.x) + std::abs(to.y - from.y) == 1;
+        const float t = adjacent ? alpha : 1.0f;
+        out.x = (float)from.x + ((float)to.x - (float)from.x) * t;
+        out.y = (float)from.y + ((float)to.y - (float)from.y) * t;
+    };
+    const std::size_t n = snap.body.size();
+    lerp(snap.prevTail, snap.body.front(), instances[ghostIdx]);
+    if (snap.moved) lerp(snap.body[n - 2], snap.body[n - 1], instances[headIdx]);
+
+    // La cola fantasma y la cabeza son las únicas instancias que cambian entre ticks.
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(ghostIdx * sizeof(CellInstance)),
+                    sizeof(CellInstance), &instances[ghostIdx]);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(headIdx * sizeof(CellInstance)),
+                    sizeof(CellInstance), &instances[headIdx]);
+}
+
+void App::drawGrid(const BoardSnapshot& snap) const {
+    glUseProgram(gridProg);
+    glUniformMatrix4fv(uGridProjLoc, 1, GL_FALSE, proj);
+    glUniform2f(uGridSizeLoc, (float)snap.cols, (float)snap.rows);
+    glBindVertexArray(gridVao);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+}
+
+void App::drawFrame() const {
+    const BoardSnapshot& snap = snapshots->front();
+    if (snap.won)       glClearColor(0.05f, 0.30f, 0.10f, 1.0f);
+    else if (snap.over) glClearColor(0.30f, 0.05f, 0.05f, 1.0f);
+    else                glClearColor(0.05f, 0.10f, 0.20f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    drawGrid(snap);
+
+    // Comida y serpiente: una sola llamada instanciada sobre el buffer del snapshot.
     glUseProgram(prog);
     glUniformMatrix4fv(uProjLoc, 1, GL_FALSE, proj);
-    glUniform2f(uCellLoc, cx, cy);
-    glUniform4f(uColorLoc, r, g, b, a);
     glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(instances.size()));
 }
 
-void App::drawGrid() const {
-    const int W = game->cols(), H = game->rows();
-    for (int y = 0; y < H; ++y) {
-        for (int x = 0; x < W; ++x) {
-            const bool odd = ((x + y) & 1) != 0;
-            const float a = odd ? 0.12f : 0.16f;
-            const float b = odd ? 0.18f : 0.22f;
-            drawCell((float)x, (float)y, 0.10f + a, 0.15f + b, 0.20f + a, 1.0f);
+void App::updateWindowTitle(const BoardSnapshot& snap) const {
+    if (!window) return;
+    const char* mode = (snap.border == Game::Border::Wrap) ? "WRAP" : "WALLS";
+    const char* state = snap.won  ? " | YOU WIN (R)"
+                      : snap.over ? " | GAME OVER (R)" : "";
+    char fast[64] = "";
+    if (snap.speed == SimSpeed::Turbo)            std::snprintf(fast, sizeof(fast), " | TURBO %.0f t/s", snap.ticksPerSecond);
+    else if (snap.speed == SimSpeed::FastForward) std::snprintf(fast, sizeof(fast), " | FF %.0f t/s", snap.ticksPerSecond);
+    // Solo aparece tras algún parón: ticks recuperados (+) y descartados (-).
+    char lag[64] = "";
+    if (snap.caughtUpTicks || snap.droppedTicks) {
+        std::snprintf(lag, sizeof(lag), " | LAG +%llu -%llu",
+                      (unsigned long long)snap.caughtUpTicks, (unsigned long long)snap.droppedTicks);
+    }
+    char buf[200];
+    std::snprintf(buf, sizeof(buf),
+                  "Snake OpenGL v1.0 | SCORE: %d | %.1f Hz%s%s | %s%s%s",
+                  snap.score, 1e9 / (double)snap.tickIntervalNs, fast, snap.autopilot ? " | AUTO" : "",
+                  mode, state, lag);
+    glfwSetWindowTitle(window, buf);
+}
+
+// ---------------- Simulación (hilo propio) ----------------
+
+void App::publishSnapshot() {
+    BoardSnapshot& snap = snapshots->back();
+    snap.capture(*game);
+    snap.tickNs  = tickNs;
+    snap.tickIntervalNs = nextTickNs - tickNs;
+    snap.caughtUpTicks = caughtUpTicks;
+    snap.droppedTicks  = droppedTicks;
+    snap.speed = speed;
+    snap.ticksPerSecond = measuredTps;
+    snap.autopilot = autopilotOn;
+    // En turbo se salta de un estado a otro varios ticks después: no hay tramo que interpolar.
+    if (speed != SimSpeed::Normal) {
+        snap.moved = false;
+        snap.prevTail = snap.body.front();
+    }
+    snap.version = ++published;
+    snapshots->publish();
+}
+
+void App::applyCommand(Command c) {
+    switch (c) {
+        case Command::Up:    game->setPendingDir(Dir::Up);    break;
+        case Command::Down:  game->setPendingDir(Dir::Down);  break;
+        case Command::Left:  game->setPendingDir(Dir::Left);  break;
+        case Command::Right: game->setPendingDir(Dir::Right); break;
+        case Command::Reset:
+            if (recorder.recording()) saveReplay();
+            game->reset();
+            if (!config.recordDir.empty()) recorder.begin(*game);
+            break;
+        case Command::ToggleBorder:
+            game->setBorderMode(game->borderModeMode() == Game::Border::Wrap
+                                ? Game::Border::Walls
+                                : Game::Border::Wrap);
+            recorder.onBorderToggle();
+            break;
+        case Command::CycleSpeed:
+            speed = speed == SimSpeed::Normal ? SimSpeed::Turbo
+                  : speed == SimSpeed::Turbo  ? SimSpeed::FastForward
+                                              : SimSpeed::Normal;
+            rateTicks = 0;
+            rateStartNs = steadyNs();
+            measuredTps = 0.0;
+            // Al volver a tiempo real se retoma desde ahora, sin ticks atrasados que recuperar.
+            nextTickNs = steadyNs() + tickStepNs();
+            break;
+        case Command::ToggleAutopilot:
+            autopilotOn = !autopilotOn;
+            break;
+    }
+}
+
+std::int64_t App::tickStepNs() const noexcept {
+    // Intervalo de juego según la puntuación, pasado a tiempo real con la dilatación.
+    const double ns = (double)config.speed.intervalNs(game->score()) / config.timeScale;
+    return std::max<std::int64_t>(1, static_cast<std::int64_t>(ns + 0.5));
+}
+
+int App::catchUpLimit() const noexcept {
+    if (config.maxCatchUp > 0) return config.maxCatchUp;
+    // Automático: ~100 ms de juego a la frecuencia actual, para que a muchos Hz un parón corto
+    // se recupere entero en vez de descartarse.
+    constexpr std::int64_t BUDGET_NS = 100'000'000;
+    return static_cast<int>(std::clamp<std::int64_t>(BUDGET_NS / tickStepNs(), 5, 1000));
+}
+
+bool App::stepGame() {
+    TRACE_SCOPE("tick");
+    if (autopilotOn) {
+        // Con muros y tablero impar x impar no hay ciclo: se queda el A*.
+        if (cyclePilot && cyclePilot->hasCycle(game->borderModeMode())) {
+            TRACE_SCOPE("CyclePilot::drive");
+            cyclePilot->drive(*game);
+        } else {
+            TRACE_SCOPE("Autopilot::drive");
+            autopilot->drive(*game);
         }
     }
+    const TickDelta& d = game->tick();
+    if (recorder.recording()) {
+        recorder.onTick(*game);
+        if (d.died) saveReplay();
+    }
+    return d.moved || d.died;
 }
 
-void App::drawFrame() const {
-    if (game->gameOver()) glClearColor(0.30f, 0.05f, 0.05f, 1.0f);
-    else                  glClearColor(0.05f, 0.10f, 0.20f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+bool App::runFast(std::int64_t now) {
+    // Turbo: K ticks por frame. Avance rápido: ticks hasta agotar el frame (se mira el reloj
+    // cada pocos ticks, que un tick cuesta menos que leerlo). El render solo ve el último estado.
+    constexpr std::int64_t FRAME_NS = 1'000'000'000 / 60;
+    constexpr int CLOCK_EVERY = 64;
+    bool changed = false;
+    std::uint64_t n = 0;
+    if (speed == SimSpeed::Turbo) {
+        for (int i = 0; i < config.turboTicks && !game->gameOver(); ++i, ++n) changed |= stepGame();
+    } else {
+        const std::int64_t end = now + FRAME_NS;
+        while (!game->gameOver()) {
+            changed |= stepGame();
+            if (++n % CLOCK_EVERY == 0 && steadyNs() >= end) break;
+        }
+    }
+    tickNs = now;
+    nextTickNs = now + FRAME_NS;
+
+    // Ticks/s sobre ventanas de medio segundo.
+    rateTicks += n;
+    const std::int64_t t = steadyNs();
+    if (t - rateStartNs >= 500'000'000) {
+        measuredTps = (double)rateTicks * 1e9 / (double)(t - rateStartNs);
+        rateTicks = 0;
+        rateStartNs = t;
+        changed = true;
+    }
+    return changed;
+}
 
-    drawGrid();
+void App::simLoop() {
+    trace::setThreadName("sim");
+    tickNs = steadyNs();
+    nextTickNs = tickNs + tickStepNs();
+
+    while (simRunning.load(std::memory_order_acquire)) {
+        bool changed = false;
+        Command c{};
+        while (commands.pop(c)) {
+            applyCommand(c);
+            changed |= (c == Command::Reset || c == Command::ToggleBorder || c == Command::CycleSpeed
+                        || c == Command::ToggleAutopilot);
+        }
+
+        const std::int64_t now = steadyNs();
+        if (speed != SimSpeed::Normal) {
+            changed |= runFast(now);
+        } else {
+            // Plazos enteros: cada tick avanza nextTickNs exactamente un intervalo, así que no hay
+            // error de redondeo que acumular ni deriva en sesiones largas.
+            const int maxRun = catchUpLimit();
+            // Solo cuenta como recuperación el retraso de más de un intervalo (y más que lo que
+            // sleep_until se pasa de normal): a 1 kHz ese exceso ya daría dos ticks por vuelta.
+            constexpr std::int64_t JITTER_NS = 2'000'000;
+            const std::int64_t lateNs = std::max(tickStepNs(), JITTER_NS);
+            int ran = 0;
+            while (now >= nextTickNs && ran < maxRun) {
+                if (now - nextTickNs > lateNs) ++caughtUpTicks;
+                changed |= stepGame();
+                // La interpolación del render parte del plazo del tick, no de cuándo se ejecutó.
+                tickNs = nextTickNs;
+                nextTickNs += tickStepNs(); // el intervalo puede cambiar con la puntuación
+                ++ran;
+            }
+
+            // Tras un parón (ventana arrastrada, depurador, suspensión) no se recupera todo de golpe:
+            // como mucho catchUpLimit() ticks y el resto se descarta, así el juego se ralentiza en vez de saltar.
+            if (now >= nextTickNs) {
+                const std::int64_t step = tickStepNs();
+                const std::int64_t late = now - nextTickNs;
+                const std::int64_t dropped = late / step + 1;
+                droppedTicks += static_cast<std::uint64_t>(dropped);
+                nextTickNs += dropped * step;
+                changed = true;
+            }
+        }
 
-    // Comida
-    const Cell& f = game->foodCell();
-    drawCell((float)f.x, (float)f.y, 1.0f, 0.3f, 0.3f, 1.0f);
+        if (changed) {
+            TRACE_SCOPE("publishSnapshot");
+            publishSnapshot();
+        }
 
-    // Snake
-    const auto& s = game->snake();
-    for (std::size_t i = 0; i < s.size(); ++i) {
-        const Cell& c = s[i];
-        const bool head = (i + 1 == s.size());
-        if (head) drawCell((float)c.x, (float)c.y, 0.2f, 1.0f, 0.4f, 1.0f);
-        else      drawCell((float)c.x, (float)c.y, 0.2f, 0.8f, 1.0f, 1.0f);
+        // Dormir hasta el próximo tick (o frame, en turbo); el input pendiente solo importa en ese
+        // tick. El avance rápido no duerme salvo con la partida terminada.
+        if (speed != SimSpeed::FastForward || game->gameOver()) sleepUntilNs(nextTickNs);
     }
+
+    // Al cerrar la ventana se guarda el episodio en curso (sin muerte).
+    if (recorder.recording()) saveReplay();
 }
 
-void App::updateWindowTitle() const {
-    if (!game || !window) return;
-    const char* mode = (currentBorder == Game::Border::Wrap) ? "WRAP" : "WALLS";
-    char buf[160];
-    std::snprintf(buf, sizeof(buf),
-                  "Snake OpenGL v1.0 | SCORE: %d | %s%s",
-                  game->score(), mode, game->gameOver() ? " | GAME OVER (R)" : "");
-    glfwSetWindowTitle(window, buf);
+void App::saveReplay() {
+    recorder.finish(*game);
+    char name[64];
+    std::snprintf(name, sizeof(name), "/snake_%016llx.snkr",
+                  static_cast<unsigned long long>(recorder.replay().seed));
+    const std::string path = config.recordDir + name;
+    if (!recorder.replay().save(path)) std::cerr << "[REPLAY] No se pudo escribir " << path << "\n";
 }
 
+// ---------------- Render (hilo principal) ----------------
+
 void App::mainLoop() {
+    trace::setThreadName("render");
     while (!glfwWindowShouldClose(window)) {
-        const double now = glfwGetTime();
-        const double dt  = now - lastTime;
-        lastTime = now;
-        acc += dt;
-
-        while (acc >= TICK) {
-            game->tick();
-            acc -= TICK;
+        TRACE_SCOPE("frame");
+        {
+            TRACE_SCOPE("glfwPollEvents");
+            glfwPollEvents();
         }
 
-        updateWindowTitle();
-        glfwPollEvents();
-        drawFrame();
-        glfwSwapBuffers(window);
+        // El snapshot más reciente y completo; si no hay uno nuevo se redibuja el anterior.
+        if (snapshots->consume()) {
+            TRACE_SCOPE("uploadSnapshot");
+            uploadSnapshot(snapshots->front());
+            titleDirty = true;
+        }
+        if (titleDirty) {
+            TRACE_SCOPE("updateWindowTitle");
+            updateWindowTitle(snapshots->front());
+            titleDirty = false;
+        }
+
+        {
+            TRACE_SCOPE("drawFrame");
+            interpolate(snapshots->front());
+            drawFrame();
+        }
+        {
+            TRACE_SCOPE("glfwSwapBuffers");
+            glfwSwapBuffers(window);
+        }
     }
 }
 
 void App::run() {
+    trace::setEnabled(config.traceAtStart);
+    simRunning.store(true, std::memory_order_release);
+    simThread = std::thread([this] { simLoop(); });
     mainLoop();
+    simRunning.store(false, std::memory_order_release);
+    simThread.join();
+    if (trace::enabled()) toggleTrace(); // lo grabado hasta el cierre también se vuelca
+}
+
+// ---------------- Trazas ----------------
+
+void App::toggleTrace() {
+    if (!trace::enabled()) {
+        trace::clear();
+        trace::setEnabled(true);
+        std::cout << "[TRACE] Grabando (F9 para volcar)\n";
+        return;
+    }
+    trace::setEnabled(false);
+    if (trace::dump(config.traceFile)) std::cout << "[TRACE] Escrita en " << config.traceFile << "\n";
+    else                               std::cerr << "[TRACE] No se pudo escribir " << config.traceFile << "\n";
 }
 
 // ---------------- Input ----------------
@@ -254,19 +605,17 @@ void App::handleKey(int key, int action) noexcept {
     if (!game) return;
     if (action != GLFW_PRESS && action != GLFW_REPEAT) return;
 
+    // Game pertenece al hilo de simulación: aquí solo se encolan órdenes (si la cola está llena, se descartan).
     switch (key) {
-        case GLFW_KEY_UP:    game->setPendingDir(Dir::Up);    break;
-        case GLFW_KEY_DOWN:  game->setPendingDir(Dir::Down);  break;
-        case GLFW_KEY_LEFT:  game->setPendingDir(Dir::Left);  break;
-        case GLFW_KEY_RIGHT: game->setPendingDir(Dir::Right); break;
-        case GLFW_KEY_R:     game->reset();                   break;
-        case GLFW_KEY_M:
-            currentBorder = (currentBorder == Game::Border::Wrap)
-                          ? Game::Border::Walls
-                          : Game::Border::Wrap;
-            game->setBorderMode(currentBorder);
-            updateWindowTitle();
-            break;
+        case GLFW_KEY_UP:    commands.push(Command::Up);           break;
+        case GLFW_KEY_DOWN:  commands.push(Command::Down);         break;
+        case GLFW_KEY_LEFT:  commands.push(Command::Left);         break;
+        case GLFW_KEY_RIGHT: commands.push(Command::Right);        break;
+        case GLFW_KEY_R:     commands.push(Command::Reset);        break;
+        case GLFW_KEY_M:     commands.push(Command::ToggleBorder); break;
+        case GLFW_KEY_F:     if (action == GLFW_PRESS) commands.push(Command::CycleSpeed); break;
+        case GLFW_KEY_A:     if (action == GLFW_PRESS) commands.push(Command::ToggleAutopilot); break;
+        case GLFW_KEY_F9:    if (action == GLFW_PRESS) toggleTrace(); break;
         default: break;
     }
 }
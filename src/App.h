@@ -1,11 +1,38 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include <cstdio>     // snprintf
+#include "Autopilot.h"
+#include "CyclePilot.h"
 #include "Game.h"
+#include "Replay.h"
+#include "Snapshot.h"
+#include "SpeedCurve.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
 
 // Forward-declare evita incluir GLFW en el header.
 struct GLFWwindow;
 
+/**
+ * @brief Opciones de arranque de la aplicación (línea de comandos).
+ */
+struct AppConfig {
+    std::string recordDir; ///< @brief Carpeta donde guardar repeticiones (vacío = no grabar).
+    std::string traceFile = "snake_trace.json"; ///< @brief Destino de la traza (F9 o al salir).
+    bool traceAtStart = false; ///< @brief Empezar trazando desde el arranque.
+    SpeedCurve speed;          ///< @brief Frecuencia de ticks (fija o creciente con la puntuación).
+    int  maxCatchUp = 0;       ///< @brief Ticks máximos por vuelta del bucle (0 = los de ~100 ms, mínimo 5); el retraso sobrante se descarta.
+    double timeScale = 1.0;    ///< @brief Dilatación: segundos de juego por segundo real (< 1 = cámara lenta).
+    int  turboTicks = 10;      ///< @brief Ticks por frame en modo turbo.
+    bool autopilot = false;    ///< @brief Empezar con el piloto automático (tecla A).
+    bool cyclePilot = false;   ///< @brief Piloto por ciclo hamiltoniano en vez de A* (si el modo lo admite).
+};
+
 /**
  * @brief Capa de aplicación: ventana, contexto OpenGL, bucle principal y render 2D.
  *
@@ -14,11 +41,18 @@ struct GLFWwindow;
  *  - Configurar estado base de OpenGL (2D).
  *  - Gestionar input y temporización con timestep fijo.
  *  - Renderizar rejilla, comida y serpiente.
+ *  - Trazar (F9) el bucle principal y los ticks en formato Chrome trace.
+ *
+ * Hilos: la simulación (timestep fijo) corre en su propio hilo y es la única
+ * dueña de Game. Publica snapshots inmutables en un triple buffer y recibe el
+ * input por una cola SPSC; el hilo principal (GLFW + GL) solo dibuja el último
+ * snapshot completo, así que ni un swap lento retrasa ticks ni un tick largo
+ * retrasa frames.
  */
 class App {
 public:
-    /// @brief Construye la app con tamaño de ventana y título.
-    App(int width, int height, const char* title) noexcept;
+    /// @brief Construye la app con tamaño de ventana, título y opciones.
+    App(int width, int height, const char* title, AppConfig cfg = {}) noexcept;
     /// @brief Libera recursos de ventana/contexto.
     ~App();
 
@@ -35,20 +69,52 @@ private:
     int  winW;
     int  winH;
     const char* winTitle;
+    AppConfig config;
 
-    // --- Timestep fijo ---
-    double lastTime = 0.0;  ///< @brief Marca anterior.
-    double acc      = 0.0;  ///< @brief Acumulador.
-    static constexpr double TICK = 1.0 / 12.0; ///< @brief 12 Hz lógicos.
+    // --- Timestep fijo (solo hilo de simulación) ---
+    std::int64_t nextTickNs = 0; ///< @brief Plazo absoluto (steady_clock, ns) del próximo tick.
 
-    // --- Juego ---
+    // --- Juego (propiedad del hilo de simulación una vez arrancado) ---
     std::unique_ptr<Game> game;              ///< @brief Lógica de Snake.
-    Game::Border currentBorder = Game::Border::Wrap; ///< @brief Modo actual.
+    std::unique_ptr<Autopilot> autopilot;    ///< @brief Controlador automático (buffers reservados en init).
+    std::unique_ptr<CyclePilot> cyclePilot;  ///< @brief Piloto por ciclo (ciclos precalculados en init).
+    bool autopilotOn = false;                ///< @brief Piloto activo (hilo de simulación).
 
-    // --- Render (programa y geometría de celda 1x1) ---
-    unsigned int prog = 0, vao = 0, vbo = 0;
-    int uProjLoc = -1, uCellLoc = -1, uColorLoc = -1;
+    // --- Comunicación entre hilos ---
+    /// @brief Órdenes del input hacia la simulación.
+    enum class Command : std::uint8_t { Up, Down, Left, Right, Reset, ToggleBorder, CycleSpeed, ToggleAutopilot };
+    SpscQueue<Command, 64> commands;                        ///< @brief Render -> simulación.
+    std::unique_ptr<TripleBuffer<BoardSnapshot>> snapshots; ///< @brief Simulación -> render.
+    std::thread simThread;                                  ///< @brief Hilo del timestep fijo.
+    std::atomic<bool> simRunning{false};                    ///< @brief Pide parar a simThread.
+    std::uint64_t published = 0;                            ///< @brief Snapshots publicados (hilo de simulación).
+    std::int64_t tickNs = 0;                                ///< @brief Instante del último tick (hilo de simulación).
+    std::uint64_t caughtUpTicks = 0;                        ///< @brief Ticks ejecutados con más de un intervalo de retraso.
+    std::uint64_t droppedTicks  = 0;                        ///< @brief Ticks descartados por superar maxCatchUp.
+    SimSpeed speed = SimSpeed::Normal;                      ///< @brief Ritmo (hilo de simulación, tecla F).
+    std::uint64_t rateTicks = 0;                            ///< @brief Ticks en la ventana de medida actual.
+    std::int64_t rateStartNs = 0;                           ///< @brief Inicio de la ventana de medida.
+    double measuredTps = 0.0;                               ///< @brief Último ticks/s medido.
+    ReplayRecorder recorder;                                ///< @brief Grabación del episodio (hilo de simulación).
+
+    // --- Estado del render (solo hilo principal) ---
+    bool titleDirty = true; ///< @brief Hay snapshot nuevo desde el último título.
+    std::size_t ghostIdx = 0; ///< @brief Instancia de la cola interpolada.
+    std::size_t headIdx  = 0; ///< @brief Instancia de la cabeza interpolada.
+
+    // --- Render instanciado (quad 1x1 + una instancia por celda dibujada) ---
+    /// @brief Atributos por instancia: posición en la grilla y color RGBA.
+    struct CellInstance {
+        float x, y;
+        float r, g, b, a;
+    };
+    unsigned int prog = 0, vao = 0, vbo = 0, instanceVbo = 0;
+    int uProjLoc = -1;
+    // --- Fondo procedural (un quad que cubre el tablero; el damero sale del fragment shader) ---
+    unsigned int gridProg = 0, gridVao = 0;
+    int uGridProjLoc = -1, uGridSizeLoc = -1;
     float proj[16]{}; ///< @brief Matriz ortográfica column-major.
+    std::vector<CellInstance> instances; ///< @brief Comida + cuerpo del snapshot actual (capacidad reservada).
 
     // --- Arranque OpenGL/GLFW ---
     bool initGLFW();
@@ -56,13 +122,27 @@ private:
     void logGLInfo() const;
     void configureBaseGLState();
 
+    // --- Simulación ---
+    void simLoop();
+    void applyCommand(Command c);
+    std::int64_t tickStepNs() const noexcept;
+    int catchUpLimit() const noexcept;
+    bool stepGame();
+    bool runFast(std::int64_t now);
+    void publishSnapshot();
+    void saveReplay();
+
     // --- Bucle y dibujo ---
     void mainLoop();
     void initRenderer2D(int gridW, int gridH);
-    void drawCell(float cx, float cy, float r, float g, float b, float a) const;
-    void drawGrid() const;
+    void uploadSnapshot(const BoardSnapshot& snap);
+    void interpolate(const BoardSnapshot& snap);
+    void drawGrid(const BoardSnapshot& snap) const;
     void drawFrame() const;
-    void updateWindowTitle() const;
+    void updateWindowTitle(const BoardSnapshot& snap) const;
+
+    // --- Trazas ---
+    void toggleTrace();
 
     // --- Input ---
     static void keyCallback(GLFWwindow* w, int key, int scancode, int action, int mods);
@@ -0,0 +1,206 @@
+#include "Autopilot.h"
+#include <algorithm> // fill, max, min
+#include <cstdlib>   // abs
+
+namespace {
+    int opposite(Dir d) noexcept {
+        switch (d) {
+            case Dir::Up:    return static_cast<int>(Dir::Down);
+            case Dir::Down:  return static_cast<int>(Dir::Up);
+            case Dir::Left:  return static_cast<int>(Dir::Right);
+            case Dir::Right: return static_cast<int>(Dir::Left);
+        }
+        return -1;
+    }
+} // namespace
+
+Autopilot::Autopilot(int cols, int rows)
+    : C(cols), R(rows), space(cols, rows) {
+    const std::size_t n = static_cast<std::size_t>(C) * R;
+    seg.assign(n, 0);
+    nodes.assign(n, Node{0, 0, -1, -1, -1, 0, false});
+    bucket.assign(n + static_cast<std::size_t>(C) + R + 2, -1); // f <= g + h <= C*R + C + R
+    path.assign(n, 0);
+}
+
+void Autopilot::nextSegGeneration() noexcept {
+    if (++segGen == 0) {
+        std::fill(seg.begin(), seg.end(), std::uint64_t{0});
+        segGen = 1;
+    }
+}
+
+void Autopilot::annotateBody(const Game& g) noexcept {
+    nextSegGeneration();
+    const std::uint64_t tag = std::uint64_t{segGen} << 32;
+    std::uint64_t k = 0;
+    const auto& body = g.snake();
+    for (const auto part : {body.firstSegment(), body.secondSegment()})
+        for (const Cell& c : part) seg[c.y * C + c.x] = tag | k++;
+}
+
+void Autopilot::neighbors(int idx, int out[4]) const noexcept {
+    const int y = idx / C;
+    const int x = idx - y * C;
+    out[0] = y > 0     ? idx - C : (wrap ? idx + (R - 1) * C : -1); // Up
+    out[1] = y < R - 1 ? idx + C : (wrap ? x : -1);                 // Down
+    out[2] = x > 0     ? idx - 1 : (wrap ? idx + (C - 1) : -1);     // Left
+    out[3] = x < C - 1 ? idx + 1 : (wrap ? idx - (C - 1) : -1);     // Right
+}
+
+int Autopilot::heuristic(int idx, int tx, int ty) const noexcept {
+    const int y = idx / C;
+    int dx = std::abs(idx - y * C - tx);
+    int dy = std::abs(y - ty);
+    if (wrap) {
+        dx = std::min(dx, C - dx);
+        dy = std::min(dy, R - dy);
+    }
+    return dx + dy;
+}
+
+void Autopilot::link(int idx, int f) noexcept {
+    Node& n = nodes[idx];
+    n.prev = -1;
+    n.next = bucket[f];
+    if (n.next >= 0) nodes[n.next].prev = idx;
+    bucket[f] = idx;
+}
+
+void Autopilot::unlink(int idx, int f) noexcept {
+    const Node& n = nodes[idx];
+    if (n.prev >= 0) nodes[n.prev].next = n.next;
+    else             bucket[f] = n.next;
+    if (n.next >= 0) nodes[n.next].prev = n.prev;
+}
+
+bool Autopilot::search(int start, int target, int back, int t0) {
+    if (++searchGen == 0) {
+        for (Node& n : nodes) n.stamp = 0;
+        searchGen = 1;
+    }
+    const int ty = target / C;
+    const int tx = target - ty * C;
+
+    // Con heurística consistente f no baja al expandir: basta recorrer los cubos hacia arriba.
+    const int fLo = t0 + heuristic(start, tx, ty);
+    int fHi = fLo;
+    nodes[start] = {searchGen, t0, -1, -1, -1, 0, false};
+    link(start, fLo);
+
+    bool found = false;
+    for (int f = fLo; ; ) {
+        while (f <= fHi && bucket[f] < 0) ++f;
+        if (f > fHi) break;
+        const int cur = bucket[f];
+        unlink(cur, f);
+        nodes[cur].closed = true;
+        if (cur == target) { found = true; break; }
+
+        const int t = nodes[cur].dist + 1;
+        int nbs[4];
+        neighbors(cur, nbs);
+        for (int d = 0; d < 4; ++d) {
+            const int nb = nbs[d];
+            if (nb < 0 || (cur == start && d == back)) continue; // el giro de 180º se ignora en Game
+            Node& n = nodes[nb];
+            const bool fresh = n.stamp != searchGen;
+            if (!fresh && (n.closed || n.dist <= t)) continue;
+            // Sin registrar si aún está ocupada: otro camino más largo puede llegar a tiempo.
+            if (!passable(nb, t)) continue;
+            const int h = heuristic(nb, tx, ty);
+            if (!fresh) unlink(nb, n.dist + h);
+            n.stamp  = searchGen;
+            n.dist   = t;
+            n.parent = cur;
+            n.move   = static_cast<std::uint8_t>(d);
+            n.closed = false;
+            link(nb, t + h);
+            fHi = std::max(fHi, t + h);
+        }
+    }
+    for (int f = fLo; f <= fHi; ++f) bucket[f] = -1; // deja los cubos vacíos para la próxima
+    return found;
+}
+
+bool Autopilot::safeAfterEating(const Game& g) {
+    // Cuerpo virtual tras comer en el tick T: segmentos originales T-1..n-1 y luego el camino.
+    const auto& body = g.snake();
+    const int n = static_cast<int>(body.size());
+    const int T = nodes[path[0]].dist; // path[0] = comida
+    const int kept = n + 1 - T;        // segmentos originales que siguen (puede ser <= 0)
+
+    nextSegGeneration();
+    const std::uint64_t tag = std::uint64_t{segGen} << 32;
+    for (int k = std::max(0, T - 1); k < n; ++k) {
+        const Cell& c = body[static_cast<std::size_t>(k)];
+        seg[c.y * C + c.x] = tag | static_cast<std::uint64_t>(k - (T - 1));
+    }
+    // path va de la comida hacia la cabeza: path[i] es el paso T - i.
+    for (int i = 0; i < T; ++i) {
+        const int idx = kept + (T - 1 - i);
+        if (idx >= 0) seg[path[i]] = tag | static_cast<std::uint64_t>(idx);
+    }
+
+    int tail;
+    if (kept > 0) {
+        const Cell& c = body[static_cast<std::size_t>(T - 1)];
+        tail = c.y * C + c.x;
+    } else {
+        tail = path[n]; // paso T - n del camino
+    }
+    return search(path[0], tail, -1, 0);
+}
+
+Dir Autopilot::decide(const Game& g) {
+    wrap = g.borderModeMode() == Game::Border::Wrap;
+    const auto& body = g.snake();
+    const Cell& h = body.back();
+    const int head = h.y * C + h.x;
+    const int back = opposite(g.dir());
+
+    annotateBody(g);
+    const Cell& food = g.foodCell();
+    if (food.x >= 0 && search(head, food.y * C + food.x, back, 0)) {
+        int len = 0;
+        for (int c = food.y * C + food.x; c != head; c = nodes[c].parent) path[len++] = c;
+        const Dir first = static_cast<Dir>(nodes[path[len - 1]].move);
+        if (safeAfterEating(g)) return first;
+        annotateBody(g); // safeAfterEating dejó anotado el cuerpo virtual
+    }
+
+    // Perseguir la cola (siempre se puede ir detrás de ella) por el camino más largo de los
+    // disponibles: el cuerpo se estira y acaba abriendo un camino seguro a la comida. Si ninguna
+    // jugada llega a la cola, la que deje más área alcanzable.
+    const Cell& t = body.front();
+    const int tail = t.y * C + t.x;
+    Dir best = g.dir();
+    int bestDist = -1;
+    std::size_t bestArea = 0;
+    bool any = false;
+    bool spaceLoaded = false;
+    int nbs[4];
+    neighbors(head, nbs);
+    for (int d = 0; d < 4; ++d) {
+        const int nb = nbs[d];
+        if (d == back || nb < 0 || !passable(nb, 1)) continue;
+        const int toTail = search(nb, tail, -1, 1) ? nodes[tail].dist : -1;
+        std::size_t area = 0;
+        if (toTail < 0 && bestDist < 0) { // solo hace falta para decidir entre jugadas sin cola
+            if (!spaceLoaded) { space.load(g); spaceLoaded = true; }
+            area = space.reachableAfter(g, static_cast<Dir>(d));
+        }
+        if (!any || toTail > bestDist || (toTail == bestDist && area > bestArea)) {
+            any = true;
+            best = static_cast<Dir>(d);
+            bestDist = toTail;
+            bestArea = area;
+        }
+    }
+    return best;
+}
+
+void Autopilot::drive(Game& g) {
+    if (g.gameOver() || g.queuedTurns() != 0) return;
+    g.setPendingDir(decide(g));
+}
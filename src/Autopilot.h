@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Bitboard.h"
+#include "Game.h"
+
+/**
+ * @brief Controlador automático: camino más corto y seguro hasta la comida.
+ *
+ * Búsqueda A* sobre el tablero desde la cabeza, con distancia Manhattan como
+ * heurística (toroidal si el modo es Border::Wrap). Es exacta como una búsqueda
+ * en anchura pero en un tablero abierto expande del orden de la longitud del
+ * camino, no del área. El cuerpo bloquea según el tiempo: el segmento k (0 = cola)
+ * deja su celda libre tras k + 1 ticks, así que una celda del cuerpo es
+ * transitable si se llega a ella después de que la cola la haya dejado.
+ *
+ * Un camino a la comida solo se toma si es seguro: en la posición que
+ * quedaría tras comer, la cabeza todavía alcanza su propia cola. Si no lo es
+ * (o no hay camino) persigue la cola por la jugada que más la aleja de ella, y
+ * si ninguna la alcanza, elige la jugada legal que deja más área alcanzable
+ * (relleno por bits de SpaceProbe).
+ *
+ * Todos los buffers se reservan en el constructor y se reutilizan entre
+ * llamadas con sellos de generación (no hace falta limpiarlos); la cola de
+ * prioridad son cubos por valor de f con listas enlazadas dentro de nodes.
+ * decide() no asigna memoria.
+ */
+class Autopilot {
+public:
+    /// @brief Reserva los buffers de búsqueda para un tablero cols x rows.
+    Autopilot(int cols, int rows);
+
+    /// @brief Dirección para el próximo tick de g (la actual si no hay ninguna legal).
+    Dir decide(const Game& g);
+
+    /// @brief Si g sigue en juego y no hay giros encolados, encola decide(g).
+    void drive(Game& g);
+
+private:
+    /// @brief Estado de búsqueda de una celda (válido si stamp == searchGen).
+    struct Node {
+        std::uint32_t stamp;
+        std::int32_t  dist;   ///< @brief Ticks desde el origen (g).
+        std::int32_t  parent; ///< @brief Celda anterior del camino.
+        std::int32_t  prev;   ///< @brief Anterior en su cubo (-1 = primero).
+        std::int32_t  next;   ///< @brief Siguiente en su cubo (-1 = último).
+        std::uint8_t  move;   ///< @brief Dirección con la que se llegó.
+        bool          closed; ///< @brief Ya expandido.
+    };
+
+    int C;
+    int R;
+    bool wrap = true;                      ///< @brief Modo de borde de la búsqueda en curso.
+
+    std::uint32_t segGen = 0;              ///< @brief Generación de seg (una por cuerpo anotado).
+    std::uint32_t searchGen = 0;           ///< @brief Generación de nodes (una por búsqueda).
+    std::vector<std::uint64_t> seg;        ///< @brief Celda -> (segGen << 32) | índice de segmento (0 = cola).
+    std::vector<Node> nodes;               ///< @brief Celda -> estado de búsqueda.
+    std::vector<int> bucket;               ///< @brief f -> primera celda abierta con ese f (-1 = vacío).
+    std::vector<int> path;                 ///< @brief Camino cabeza -> comida (sin la cabeza).
+    SpaceProbe space;                      ///< @brief Área libre por jugada (último recurso).
+
+    /// @brief Abre una generación nueva de seg (lo limpia solo al desbordar el contador).
+    void nextSegGeneration() noexcept;
+
+    /// @brief Anota el cuerpo real de g en seg.
+    void annotateBody(const Game& g) noexcept;
+
+    /// @brief Vecinos de idx en el orden de Dir (Up, Down, Left, Right); -1 = fuera con muros.
+    void neighbors(int idx, int out[4]) const noexcept;
+
+    /// @brief ¿Se puede pisar idx en el tick t (1 = el próximo)?
+    bool passable(int idx, int t) const noexcept {
+        const std::uint64_t v = seg[idx];
+        return (v >> 32) != segGen || static_cast<std::int64_t>(v & 0xffffffffu) < t;
+    }
+
+    /**
+     * @brief A* de start a target con el cuerpo anotado en seg.
+     * @param back Dirección prohibida en el primer paso (-1 = ninguna).
+     * @param t0   Ticks ya transcurridos al estar en start.
+     * @return ¿Se alcanzó target? El camino queda en nodes (parent/move/dist).
+     */
+    bool search(int start, int target, int back, int t0);
+
+    /// @brief Distancia Manhattan (toroidal con wrap) de idx a (tx, ty).
+    int heuristic(int idx, int tx, int ty) const noexcept;
+
+    /// @brief Mete idx en el cubo f (por delante: desempata a favor del más profundo).
+    void link(int idx, int f) noexcept;
+    /// @brief Saca idx del cubo f.
+    void unlink(int idx, int f) noexcept;
+
+    /// @brief ¿Tras recorrer path y comer, la cabeza (en la comida) alcanza su cola?
+    bool safeAfterEating(const Game& g);
+};
@@ -0,0 +1,77 @@
+#include "BatchRunner.h"
+#include <algorithm> // max, min
+#include <chrono>
+#include <span>
+
+void EpisodeStats::merge(const EpisodeStats& o) noexcept {
+    episodes        += o.episodes;
+    wins            += o.wins;
+    ticks           += o.ticks;
+    scoreSum        += o.scoreSum;
+    lengthSum       += o.lengthSum;
+    episodeTicksSum += o.episodeTicksSum;
+    maxScore        = std::max(maxScore, o.maxScore);
+    maxLength       = std::max(maxLength, o.maxLength);
+    maxEpisodeTicks = std::max(maxEpisodeTicks, o.maxEpisodeTicks);
+}
+
+BatchRunner::BatchRunner(GameBatch& b, ThreadPool& p, std::uint64_t seed)
+    : batch(b), pool(p), locals(p.size()), actions(b.size(), Dir::Right) {
+    // Mezcla con una constante propia: los tableros usan seed + b tal cual para la comida y
+    // la política del tablero 0 repetiría su secuencia.
+    std::uint64_t mixed = seed ^ 0x6A09E667F3BCC909ull;
+    const std::uint64_t base = Rng::splitmix64(mixed);
+    rngs.reserve(b.size());
+    for (std::size_t i = 0; i < b.size(); ++i) rngs.emplace_back(base + i);
+}
+
+Dir BatchRunner::randomPolicy(const GameBatch& batch, std::size_t b, Rng& rng) noexcept {
+    const std::uint32_t r = rng.below(16);
+    return r < 12 ? batch.dir(b) : static_cast<Dir>(r & 3u);
+}
+
+void BatchRunner::runSlice(std::size_t begin, std::size_t end, std::uint64_t ticksPerBoard,
+                           Policy policy, Local& local) {
+    const std::span<const Dir> acts(actions);
+    EpisodeStats& st = local.stats;
+    for (std::uint64_t t = 0; t < ticksPerBoard; ++t) {
+        for (std::size_t b = begin; b < end; ++b) actions[b] = policy(batch, b, rngs[b]);
+        st.ticks += batch.stepRange(begin, end, acts);
+
+        for (std::size_t b = begin; b < end; ++b) {
+            if (!batch.gameOver(b)) continue;
+            ++st.episodes;
+            st.wins            += batch.gameWon(b) ? 1 : 0;
+            st.scoreSum        += static_cast<std::uint64_t>(batch.score(b));
+            st.lengthSum       += static_cast<std::uint64_t>(batch.length(b));
+            st.episodeTicksSum += static_cast<std::uint64_t>(batch.episodeTicks(b));
+            st.maxScore        = std::max(st.maxScore, batch.score(b));
+            st.maxLength       = std::max(st.maxLength, batch.length(b));
+            st.maxEpisodeTicks = std::max(st.maxEpisodeTicks, batch.episodeTicks(b));
+            batch.reset(b);
+        }
+    }
+}
+
+EpisodeStats BatchRunner::run(std::uint64_t ticksPerBoard, Policy policy) {
+    for (auto& l : locals) l.stats = EpisodeStats{};
+
+    // Varias rebanadas por hilo para que el robo tenga margen de equilibrar.
+    const std::size_t n = batch.size();
+    const std::size_t slices = std::max<std::size_t>(1, std::min<std::size_t>(n, std::size_t{pool.size()} * 8));
+    const std::size_t chunk = (n + slices - 1) / slices;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t begin = 0; begin < n; begin += chunk) {
+        const std::size_t end = std::min(n, begin + chunk);
+        pool.submit([this, begin, end, ticksPerBoard, policy](unsigned w) {
+            runSlice(begin, end, ticksPerBoard, policy, locals[w]);
+        });
+    }
+    pool.wait();
+
+    EpisodeStats total;
+    for (const auto& l : locals) total.merge(l.stats);
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return total;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameBatch.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Resultados agregados de episodios terminados.
+ */
+struct EpisodeStats {
+    std::uint64_t episodes     = 0; ///< @brief Episodios terminados (muerte o victoria).
+    std::uint64_t wins         = 0; ///< @brief Episodios con tablero lleno.
+    std::uint64_t ticks        = 0; ///< @brief Ticks de tablero simulados (incluye episodios a medias).
+    std::uint64_t scoreSum     = 0;
+    std::uint64_t lengthSum    = 0;
+    std::uint64_t episodeTicksSum = 0;
+    int maxScore        = 0;
+    int maxLength       = 0;
+    int maxEpisodeTicks = 0;
+    double seconds      = 0.0;      ///< @brief Tiempo de pared de la ejecución.
+
+    /// @brief Acumula otro parcial (reducción entre hilos).
+    void merge(const EpisodeStats& o) noexcept;
+
+    double meanScore() const noexcept        { return episodes ? double(scoreSum) / episodes : 0.0; }
+    double meanLength() const noexcept       { return episodes ? double(lengthSum) / episodes : 0.0; }
+    double meanEpisodeTicks() const noexcept { return episodes ? double(episodeTicksSum) / episodes : 0.0; }
+    double ticksPerSecond() const noexcept   { return seconds > 0.0 ? double(ticks) / seconds : 0.0; }
+};
+
+/**
+ * @brief Ejecuta un GameBatch en paralelo repartiendo rebanadas de tableros en un ThreadPool.
+ *
+ * Los tableros son independientes, así que cada rebanada avanza todos sus
+ * ticks sin sincronizarse con las demás; el robo de tareas equilibra rebanadas
+ * desiguales (episodios que mueren y se reinician a distinto ritmo). Cada
+ * tablero tiene su RNG de política, así que con la misma semilla las acciones
+ * no dependen de qué hilo ejecute cada rebanada ni de cuántos haya. Cada
+ * trabajador acumula su parcial de EpisodeStats; los tableros terminados se
+ * registran y reinician solos.
+ */
+class BatchRunner {
+public:
+    /// @brief Política: decide la acción del tablero b con el RNG de ese tablero.
+    using Policy = Dir (*)(const GameBatch& batch, std::size_t b, Rng& rng);
+
+    /**
+     * @param batch Tableros a simular (el runner no es su dueño).
+     * @param pool  Trabajadores.
+     * @param seed  Semilla de los RNG de política (uno por tablero).
+     */
+    BatchRunner(GameBatch& batch, ThreadPool& pool, std::uint64_t seed = 0);
+
+    /**
+     * @brief Avanza cada tablero ticksPerBoard ticks y devuelve los episodios terminados.
+     * @param policy Política de acciones (por defecto randomPolicy).
+     */
+    EpisodeStats run(std::uint64_t ticksPerBoard, Policy policy = &BatchRunner::randomPolicy);
+
+    /// @brief Política base: sigue recto y gira al azar una de cada cuatro veces.
+    static Dir randomPolicy(const GameBatch& batch, std::size_t b, Rng& rng) noexcept;
+
+private:
+    /// @brief Estado por trabajador, alineado para evitar falso compartido.
+    struct alignas(64) Local {
+        EpisodeStats stats;
+    };
+
+    GameBatch& batch;
+    ThreadPool& pool;
+    std::vector<Local> locals;   ///< @brief Uno por trabajador.
+    std::vector<Dir> actions;    ///< @brief Una por tablero; cada rebanada escribe solo la suya.
+    std::vector<Rng> rngs;       ///< @brief RNG de política por tablero.
+
+    void runSlice(std::size_t begin, std::size_t end, std::uint64_t ticksPerBoard,
+                  Policy policy, Local& local);
+};
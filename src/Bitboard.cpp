@@ -0,0 +1,201 @@
+#include "Bitboard.h"
+#include <algorithm> // fill, max, min
+#include <bit>       // popcount, countr_zero
+
+namespace {
+    /**
+     * @brief Relleno ocluido hacia bits altos (x creciente) de las semillas g ⊆ p.
+     *
+     * Sumar g a p propaga un acarreo por cada tramo de 1 desde su semilla hasta
+     * el final del tramo: los bits que cambian son justo los que hay que llenar.
+     */
+    std::uint64_t fillUp(std::uint64_t g, std::uint64_t p) noexcept {
+        return (((p + g) ^ p) & p) | g;
+    }
+
+    /// @brief Relleno ocluido hacia bits bajos (x decreciente) de g ⊆ p, por desplazamientos.
+    std::uint64_t fillDown(std::uint64_t g, std::uint64_t p) noexcept {
+        if (p == ~std::uint64_t{0}) return g ? ~std::uint64_t{0} >> std::countl_zero(g) : 0;
+        g |= p & (g >> 1);  p &= p >> 1;
+        g |= p & (g >> 2);  p &= p >> 2;
+        g |= p & (g >> 4);  p &= p >> 4;
+        g |= p & (g >> 8);  p &= p >> 8;
+        g |= p & (g >> 16); p &= p >> 16;
+        g |= p & (g >> 32);
+        return g;
+    }
+} // namespace
+
+// ---------------- Bitboard ----------------
+
+Bitboard::Bitboard(int cols, int rows)
+    : C(cols), R(rows), W((cols + 63) / 64),
+      lastMask((cols & 63) ? (std::uint64_t{1} << (cols & 63)) - 1 : ~std::uint64_t{0}),
+      bits(static_cast<std::size_t>(rows) * ((cols + 63) / 64), 0) {}
+
+void Bitboard::clear() noexcept {
+    std::fill(bits.begin(), bits.end(), std::uint64_t{0});
+}
+
+void Bitboard::fill() noexcept {
+    std::fill(bits.begin(), bits.end(), ~std::uint64_t{0});
+    for (int y = 0; y < R; ++y) row(y)[W - 1] = lastMask;
+}
+
+void Bitboard::subtract(const Bitboard& o) noexcept {
+    for (std::size_t i = 0; i < bits.size(); ++i) bits[i] &= ~o.bits[i];
+}
+
+std::size_t Bitboard::count() const noexcept {
+    std::size_t n = 0;
+    for (std::uint64_t w : bits) n += static_cast<std::size_t>(std::popcount(w));
+    return n;
+}
+
+Cell Bitboard::first() const noexcept {
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        if (bits[i]) {
+            const int y = static_cast<int>(i / W);
+            const int x = static_cast<int>(i % W) * 64 + std::countr_zero(bits[i]);
+            return {x, y};
+        }
+    }
+    return {-1, -1};
+}
+
+void Bitboard::fillRow(int y, const std::uint64_t* pass, bool wrap) noexcept {
+    std::uint64_t* r = row(y);
+    for (;;) {
+        // Hacia x creciente y luego decreciente; el acarreo cruza de un word al siguiente.
+        std::uint64_t carry = 0;
+        for (int w = 0; w < W; ++w) {
+            const std::uint64_t s = r[w] | (carry & pass[w]);
+            if (!s) { carry = 0; continue; }
+            r[w] = fillUp(s, pass[w]);
+            carry = r[w] >> 63;
+        }
+        carry = 0;
+        for (int w = W - 1; w >= 0; --w) {
+            const std::uint64_t s = r[w] | ((carry << 63) & pass[w]);
+            if (!s) { carry = 0; continue; }
+            r[w] = fillDown(s, pass[w]);
+            carry = r[w] & 1u;
+        }
+        if (!wrap) return;
+
+        // Con wrap, el tramo que toca la columna C-1 sigue en la 0 y viceversa.
+        const std::uint64_t lastBit = std::uint64_t{1} << ((C - 1) & 63);
+        const bool firstSet  = r[0] & 1u,        firstPass = pass[0] & 1u;
+        const bool lastSet   = r[W - 1] & lastBit, lastPass = pass[W - 1] & lastBit;
+        if (lastSet && firstPass && !firstSet)      r[0] |= 1u;
+        else if (firstSet && lastPass && !lastSet)  r[W - 1] |= lastBit;
+        else return;
+    }
+}
+
+bool Bitboard::spread(int from, int to, const Bitboard& passable, bool wrap) noexcept {
+    const std::uint64_t* src = row(from);
+    const std::uint64_t* pass = passable.row(to);
+    std::uint64_t* dst = row(to);
+    std::uint64_t gained = 0;
+    for (int w = 0; w < W; ++w) {
+        const std::uint64_t s = src[w] & pass[w] & ~dst[w];
+        dst[w] |= s;
+        gained |= s;
+    }
+    if (!gained) return false;
+    fillRow(to, pass, wrap);
+    return true;
+}
+
+std::size_t Bitboard::floodFill(const Bitboard& passable, bool wrap) noexcept {
+    // Semillas dentro de passable, relleno horizontal y banda [lo, hi] de filas con bits.
+    int lo = R, hi = -1;
+    for (int y = 0; y < R; ++y) {
+        std::uint64_t* r = row(y);
+        const std::uint64_t* pass = passable.row(y);
+        std::uint64_t any = 0;
+        for (int w = 0; w < W; ++w) any |= (r[w] &= pass[w]);
+        if (!any) continue;
+        fillRow(y, pass, wrap);
+        lo = std::min(lo, y);
+        hi = std::max(hi, y);
+    }
+    if (hi < 0) return 0;
+
+    // Barridos alternos hacia abajo y hacia arriba; solo se recorre la banda y su borde. Lo
+    // que gana el barrido hacia abajo ya ha bajado todo lo posible y el siguiente barrido hacia
+    // arriba lo sube: hace falta otra vuelta solo si algo cambió después del último barrido que
+    // lo habría llevado hacia abajo (barrido hacia arriba o paso del borde inferior al superior).
+    for (bool again = true; again; ) {
+        again = false;
+        for (int y = lo + 1; y < R && y <= hi + 1; ++y) {
+            if (spread(y - 1, y, passable, wrap)) hi = std::max(hi, y);
+        }
+        if (wrap && hi == R - 1 && R > 1 && spread(R - 1, 0, passable, wrap)) { again = true; lo = 0; }
+
+        for (int y = hi - 1; y >= 0 && y >= lo - 1; --y) {
+            if (spread(y + 1, y, passable, wrap)) { again = true; lo = std::min(lo, y); }
+        }
+        if (wrap && lo == 0 && R > 1 && spread(0, R - 1, passable, wrap)) { again = true; hi = R - 1; }
+    }
+
+    std::size_t n = 0;
+    for (const std::uint64_t* w = row(lo); w != row(hi) + W; ++w) n += static_cast<std::size_t>(std::popcount(*w));
+    return n;
+}
+
+// ---------------- SpaceProbe ----------------
+
+SpaceProbe::SpaceProbe(int cols, int rows)
+    : free(cols, rows), reach(cols, rows), pending(cols, rows) {}
+
+void SpaceProbe::load(const Game& g) {
+    wrap = g.borderModeMode() == Game::Border::Wrap;
+    free.fill();
+    const auto& body = g.snake();
+    for (const auto part : {body.firstSegment(), body.secondSegment()})
+        for (const Cell& c : part) free.reset(c);
+    if (body.size() > 1) free.set(body.front()); // la cola se va en el próximo tick (si no crece)
+}
+
+std::size_t SpaceProbe::reachable(const Cell& from) {
+    if (!free.test(from)) return 0;
+    reach.clear();
+    reach.set(from);
+    return reach.floodFill(free, wrap);
+}
+
+std::size_t SpaceProbe::reachableAfter(const Game& g, Dir d) {
+    const Dir cur = g.dir();
+    const bool reverse = (d == Dir::Up && cur == Dir::Down) || (d == Dir::Down && cur == Dir::Up)
+                      || (d == Dir::Left && cur == Dir::Right) || (d == Dir::Right && cur == Dir::Left);
+    if (reverse && g.snake().size() > 1) return 0;
+
+    Cell h = g.snake().back();
+    switch (d) {
+        case Dir::Up:    --h.y; break;
+        case Dir::Down:  ++h.y; break;
+        case Dir::Left:  --h.x; break;
+        case Dir::Right: ++h.x; break;
+    }
+    if (wrap) {
+        h.x = (h.x + free.cols()) % free.cols();
+        h.y = (h.y + free.rows()) % free.rows();
+    } else if (h.x < 0 || h.y < 0 || h.x >= free.cols() || h.y >= free.rows()) {
+        return 0;
+    }
+    return reachable(h);
+}
+
+std::size_t SpaceProbe::pockets(std::size_t minSize) {
+    pending.assign(free);
+    std::size_t n = 0;
+    for (Cell c = pending.first(); c.x >= 0; c = pending.first()) {
+        reach.clear();
+        reach.set(c);
+        if (reach.floodFill(free, wrap) < minSize) ++n;
+        pending.subtract(reach);
+    }
+    return n;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Game.h"
+
+/**
+ * @brief Tablero de bits CxR: un bit por celda, filas de words de 64 bits.
+ *
+ * La fila y ocupa stride() words seguidas; la celda (x, y) es el bit x % 64 del
+ * word x / 64 de la fila. Los bits de relleno tras la columna C-1 están siempre
+ * a 0, así que count() y las operaciones de conjunto no necesitan máscaras.
+ */
+class Bitboard {
+public:
+    /// @brief Tablero vacío de cols x rows.
+    Bitboard(int cols, int rows);
+
+    int cols() const noexcept { return C; }
+    int rows() const noexcept { return R; }
+    /// @brief Words por fila.
+    int stride() const noexcept { return W; }
+
+    bool test(const Cell& c) const noexcept {
+        return (bits[static_cast<std::size_t>(c.y) * W + (c.x >> 6)] >> (c.x & 63)) & 1u;
+    }
+    void set(const Cell& c) noexcept {
+        bits[static_cast<std::size_t>(c.y) * W + (c.x >> 6)] |= std::uint64_t{1} << (c.x & 63);
+    }
+    void reset(const Cell& c) noexcept {
+        bits[static_cast<std::size_t>(c.y) * W + (c.x >> 6)] &= ~(std::uint64_t{1} << (c.x & 63));
+    }
+
+    /// @brief Todo a 0.
+    void clear() noexcept;
+    /// @brief Todas las celdas del tablero a 1 (relleno a 0).
+    void fill() noexcept;
+    /// @brief Copia el contenido de o (mismo tamaño).
+    void assign(const Bitboard& o) noexcept { bits = o.bits; }
+    /// @brief this &= ~o.
+    void subtract(const Bitboard& o) noexcept;
+    /// @brief Nº de celdas a 1.
+    std::size_t count() const noexcept;
+    /// @brief Primera celda a 1 en orden de filas, o {-1,-1} si no hay.
+    Cell first() const noexcept;
+
+    /**
+     * @brief Relleno por inundación: expande los bits actuales (semillas) a
+     * todas las celdas de passable conectadas en 4 vecinos.
+     *
+     * Por filas: dentro de cada word, relleno ocluido sin bucles por bit (hacia
+     * x creciente con el acarreo de una suma, hacia x decreciente con 6 pasos
+     * de desplazamiento y máscara) y acarreo entre words; entre filas, barridos alternos hacia abajo y hacia arriba que
+     * solo recorren la banda de filas alcanzadas. Con wrap, conecta también
+     * los bordes opuestos. Las semillas fuera de passable se descartan.
+     *
+     * @return Nº de celdas alcanzadas.
+     */
+    std::size_t floodFill(const Bitboard& passable, bool wrap) noexcept;
+
+private:
+    int C;
+    int R;
+    int W;                           ///< @brief Words por fila.
+    std::uint64_t lastMask;          ///< @brief Bits válidos del último word de cada fila.
+    std::vector<std::uint64_t> bits; ///< @brief R * W words.
+
+    std::uint64_t* row(int y) noexcept { return bits.data() + static_cast<std::size_t>(y) * W; }
+    const std::uint64_t* row(int y) const noexcept { return bits.data() + static_cast<std::size_t>(y) * W; }
+
+    /// @brief Extiende los bits de la fila y a sus tramos completos de pass (fila y de passable).
+    void fillRow(int y, const std::uint64_t* pass, bool wrap) noexcept;
+
+    /// @brief Pasa a la fila to lo que llega de la fila from y la rellena. @return ¿Ganó celdas?
+    bool spread(int from, int to, const Bitboard& passable, bool wrap) noexcept;
+};
+
+/**
+ * @brief Espacio libre alrededor de la serpiente, con Bitboard.
+ *
+ * load() toma una foto del tablero (la cola cuenta como libre: la deja en el
+ * próximo tick si no crece) y las consultas reutilizan los tableros internos,
+ * sin asignar memoria.
+ */
+class SpaceProbe {
+public:
+    /// @brief Reserva los tableros para cols x rows.
+    SpaceProbe(int cols, int rows);
+
+    /// @brief Foto del espacio libre de g. O(cols*rows/64 + longitud).
+    void load(const Game& g);
+
+    /// @brief Celdas libres alcanzables desde from (incluida), 0 si está ocupada.
+    std::size_t reachable(const Cell& from);
+
+    /**
+     * @brief Área alcanzable tras avanzar la cabeza en d (incluida la nueva cabeza).
+     * @return 0 si la jugada choca (muro, cuerpo o giro de 180º).
+     */
+    std::size_t reachableAfter(const Game& g, Dir d);
+
+    /// @brief Regiones libres con menos de minSize celdas (bolsas sin salida para una serpiente así).
+    std::size_t pockets(std::size_t minSize);
+
+    /// @brief Espacio libre de la última foto.
+    const Bitboard& freeCells() const noexcept { return free; }
+
+private:
+    bool wrap = true;
+    Bitboard free;    ///< @brief Celdas libres de la foto.
+    Bitboard reach;   ///< @brief Resultado de la última inundación.
+    Bitboard pending; ///< @brief Libres aún sin región (pockets()).
+};
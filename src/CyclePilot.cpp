@@ -0,0 +1,173 @@
+#include "CyclePilot.h"
+#include <algorithm> // min
+
+namespace {
+    constexpr Dir DIRS[4] = {Dir::Up, Dir::Down, Dir::Left, Dir::Right};
+
+    bool isReverse(Dir a, Dir b) noexcept {
+        return (a == Dir::Up && b == Dir::Down) || (a == Dir::Down && b == Dir::Up)
+            || (a == Dir::Left && b == Dir::Right) || (a == Dir::Right && b == Dir::Left);
+    }
+} // namespace
+
+CyclePilot::CyclePilot(int cols, int rows)
+    : C(cols), R(rows), space(cols, rows) {
+    walls = buildWalls();
+    torus = buildTorus();
+}
+
+CyclePilot::Cycle CyclePilot::buildWalls() const {
+    // Serpentina sobre V líneas (V par) de L celdas: la línea 0 entera, las siguientes en
+    // zigzag sin la posición 0 y vuelta por la posición 0. Por filas si R es par, si no por columnas.
+    const bool byRows = R % 2 == 0;
+    const int L = byRows ? C : R;
+    const int V = byRows ? R : C;
+    Cycle cy;
+    if (V % 2 != 0 || L < 2) return cy;
+
+    const auto cell = [&](int u, int v) { return byRows ? v * C + u : u * C + v; };
+    cy.cells.reserve(static_cast<std::size_t>(C) * R);
+    for (int u = 0; u < L; ++u) cy.cells.push_back(cell(u, 0));
+    for (int v = 1; v < V; ++v) {
+        if (v % 2 == 1) for (int u = L - 1; u >= 1; --u) cy.cells.push_back(cell(u, v));
+        else            for (int u = 1; u < L; ++u)      cy.cells.push_back(cell(u, v));
+    }
+    for (int v = V - 1; v >= 1; --v) cy.cells.push_back(cell(0, v));
+
+    cy.order.assign(cy.cells.size(), 0);
+    for (std::size_t i = 0; i < cy.cells.size(); ++i) cy.order[cy.cells[i]] = static_cast<int>(i);
+    return cy;
+}
+
+CyclePilot::Cycle CyclePilot::buildTorus() const {
+    // Líneas completas (filas o columnas) de L celdas, una tras otra con un paso perpendicular.
+    // Recorrer una línea hacia adelante deja la siguiente empezando una posición antes (mod L);
+    // hacia atrás, una después. Con a líneas hacia adelante y b hacia atrás el ciclo cierra si
+    // b - a es múltiplo de L: con V par basta a = b; con L y V impares, |b - a| = L si L <= V.
+    Cycle cy;
+    for (const bool byRows : {true, false}) {
+        const int L = byRows ? C : R;
+        const int V = byRows ? R : C;
+        int back = -1;
+        for (int k = -(V / L); k <= V / L && back < 0; ++k) {
+            const int twiceB = V + k * L;
+            if (twiceB >= 0 && twiceB % 2 == 0 && twiceB / 2 <= V) back = twiceB / 2;
+        }
+        if (back < 0) continue;
+        const int fwd = V - back;
+
+        const auto cell = [&](int u, int v) { return byRows ? v * C + u : u * C + v; };
+        cy.cells.reserve(static_cast<std::size_t>(C) * R);
+        int u = 0;
+        for (int v = 0; v < V; ++v) {
+            // Alternas mientras queden de los dos tipos; luego las que sobren.
+            const int pairs = 2 * std::min(fwd, back);
+            const bool backward = v < pairs ? v % 2 == 1 : back > fwd;
+            cy.cells.push_back(cell(u, v));
+            for (int s = 1; s < L; ++s) {
+                u = backward ? (u + L - 1) % L : (u + 1) % L;
+                cy.cells.push_back(cell(u, v));
+            }
+        }
+        break;
+    }
+
+    cy.order.assign(cy.cells.size(), 0);
+    for (std::size_t i = 0; i < cy.cells.size(); ++i) cy.order[cy.cells[i]] = static_cast<int>(i);
+    return cy;
+}
+
+int CyclePilot::neighbor(int idx, Dir d, bool wrap) const noexcept {
+    const int y = idx / C;
+    const int x = idx - y * C;
+    switch (d) {
+        case Dir::Up:    return y > 0     ? idx - C : (wrap ? idx + (R - 1) * C : -1);
+        case Dir::Down:  return y < R - 1 ? idx + C : (wrap ? x : -1);
+        case Dir::Left:  return x > 0     ? idx - 1 : (wrap ? idx + (C - 1) : -1);
+        case Dir::Right: return x < C - 1 ? idx + 1 : (wrap ? idx - (C - 1) : -1);
+    }
+    return -1;
+}
+
+bool CyclePilot::ordered(const Game& g, const Cycle& cy) const noexcept {
+    const auto& body = g.snake();
+    const Cell& t = body.front();
+    const int tail = t.y * C + t.x;
+    int last = -1;
+    for (const auto part : {body.firstSegment(), body.secondSegment()}) {
+        for (const Cell& c : part) {
+            const int off = ahead(cy, tail, c.y * C + c.x);
+            if (off <= last) return false;
+            last = off;
+        }
+    }
+    return true;
+}
+
+Dir CyclePilot::decide(const Game& g) {
+    const Game::Border mode = g.borderModeMode();
+    const Cycle& cy = cycleFor(mode);
+    if (cy.cells.empty()) return g.dir();
+    const bool wrap = mode == Game::Border::Wrap;
+
+    const auto& body = g.snake();
+    const Cell& h = body.back();
+    const Cell& t = body.front();
+    const int head = h.y * C + h.x;
+    const int tail = t.y * C + t.x;
+    const Cell& f = g.foodCell();
+    const int food = f.x >= 0 ? f.y * C + f.x : -1;
+    const bool sync = (head == expectHead && body.size() == expectLen && mode == expectMode) || ordered(g, cy);
+
+    Dir best = g.dir();
+    int next = -1;
+    if (sync) {
+        // Todo lo que hay por delante de la cabeza hasta la cola está libre: cualquier vecino de ese
+        // tramo conserva el orden. Se salta lo más lejos posible sin pasar de la comida.
+        // Con el cuerpo por encima de medio tablero ya no se ataja: los atajos dejan huecos detrás
+        // de la cabeza y, al final, la comida cae en ellos y cuesta casi una vuelta por comida.
+        const int toTail = ahead(cy, head, tail);
+        const int toFood = food >= 0 ? ahead(cy, head, food) : 1;
+        const int reach = 2 * body.size() < cy.cells.size() ? std::min(toTail, toFood) : 1;
+        int bestStep = 0;
+        for (const Dir d : DIRS) {
+            if (isReverse(d, g.dir())) continue;
+            const int nb = neighbor(head, d, wrap);
+            if (nb < 0) continue;
+            const int s = ahead(cy, head, nb);
+            if (s < 1 || s > reach || s > toTail || s <= bestStep) continue;
+            best = d;
+            next = nb;
+            bestStep = s;
+        }
+    }
+    if (next < 0) {
+        // Desordenado: el sucesor del ciclo si está libre (tras longitud ticks seguidos el cuerpo
+        // queda ordenado); si no, la jugada con más área alcanzable.
+        const int succ = cy.cells[static_cast<std::size_t>((cy.order[head] + 1) % static_cast<int>(cy.cells.size()))];
+        std::size_t bestArea = 0;
+        bool loaded = false;
+        for (const Dir d : DIRS) {
+            if (isReverse(d, g.dir())) continue;
+            const int nb = neighbor(head, d, wrap);
+            if (nb < 0) continue;
+            const bool free = !g.occupies({nb % C, nb / C}) || (nb == tail && nb != food);
+            if (nb == succ && free) { best = d; break; }
+            if (!loaded) { space.load(g); loaded = true; }
+            const std::size_t area = space.reachableAfter(g, d);
+            if (area > bestArea) { best = d; bestArea = area; }
+        }
+        expectHead = -1;
+        return best;
+    }
+
+    expectHead = next;
+    expectLen = body.size() + (next == food ? 1 : 0);
+    expectMode = mode;
+    return best;
+}
+
+void CyclePilot::drive(Game& g) {
+    if (g.gameOver() || g.queuedTurns() != 0) return;
+    g.setPendingDir(decide(g));
+}
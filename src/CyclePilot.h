@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Bitboard.h"
+#include "Game.h"
+
+/**
+ * @brief Controlador por ciclo hamiltoniano: no muere y llena el tablero.
+ *
+ * En el constructor precalcula un ciclo que pasa una vez por cada celda para
+ * cada modo de borde: con muros, una serpentina (hace falta cols o rows par);
+ * con wrap, filas (o columnas) completas recorridas cada una hacia un lado,
+ * elegidos para que el desplazamiento total cierre el toro (existe siempre,
+ * también impar x impar).
+ *
+ * Mientras el cuerpo esté ordenado según el ciclo (de la cola a la cabeza) y
+ * los tramos del ciclo entre cabeza y cola estén libres, seguir el ciclo es
+ * seguro. Los atajos saltan hacia adelante por ese tramo libre sin pasar de
+ * la cola ni de la comida, así que se conserva el orden. Solo se atajan
+ * mientras el cuerpo ocupa menos de medio tablero; después sigue el ciclo,
+ * que deja el cuerpo compacto. Llenar el tablero cuesta así la mitad de
+ * ticks que seguir el ciclo a ciegas.
+ * Si el cuerpo no está ordenado (inicio de partida o tras jugar a mano) sigue
+ * el ciclo cuando puede y si no la jugada con más área libre, hasta ordenarse.
+ */
+class CyclePilot {
+public:
+    /// @brief Precalcula los ciclos de un tablero cols x rows (O(cols*rows)).
+    CyclePilot(int cols, int rows);
+
+    /// @brief ¿Hay ciclo para el modo? (con muros no lo hay si cols y rows son impares).
+    bool hasCycle(Game::Border m) const noexcept { return !cycleFor(m).cells.empty(); }
+
+    /// @brief Dirección para el próximo tick de g (la actual si el modo no tiene ciclo).
+    Dir decide(const Game& g);
+
+    /// @brief Si g sigue en juego y no hay giros encolados, encola decide(g).
+    void drive(Game& g);
+
+private:
+    /// @brief Ciclo: posición -> celda y celda -> posición (vacío si no existe).
+    struct Cycle {
+        std::vector<int> cells;
+        std::vector<int> order;
+    };
+
+    int C;
+    int R;
+    Cycle walls;
+    Cycle torus;
+    SpaceProbe space;       ///< @brief Área libre para reordenarse.
+
+    // Última jugada propia: si el tablero la refleja, el cuerpo sigue ordenado sin comprobarlo.
+    int expectHead = -1;
+    std::size_t expectLen = 0;
+    Game::Border expectMode = Game::Border::Wrap;
+
+    const Cycle& cycleFor(Game::Border m) const noexcept { return m == Game::Border::Wrap ? torus : walls; }
+
+    /// @brief Serpentina con muros; vacío si cols y rows son impares (o una es 1).
+    Cycle buildWalls() const;
+    /// @brief Ciclo del toro por filas (o columnas) completas.
+    Cycle buildTorus() const;
+
+    /// @brief Vecino de idx en d; -1 si sale del tablero con muros.
+    int neighbor(int idx, Dir d, bool wrap) const noexcept;
+
+    /// @brief Pasos del ciclo de a a b (hacia adelante).
+    int ahead(const Cycle& cy, int a, int b) const noexcept {
+        const int n = static_cast<int>(cy.cells.size());
+        const int d = cy.order[b] - cy.order[a];
+        return d < 0 ? d + n : d;
+    }
+
+    /// @brief ¿El cuerpo de g aparece en orden de ciclo de la cola a la cabeza? O(longitud).
+    bool ordered(const Game& g, const Cycle& cy) const noexcept;
+};
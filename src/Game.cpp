@@ -1,24 +1,90 @@
 #include "Game.h"
-#include <cstdlib> // rand
+#include <algorithm> // copy, fill
 
-Game::Game(int cols, int rows) : C(cols), R(rows) {
-    reset();
+Game::Game(int cols, int rows, std::uint64_t seed)
+    : C(cols), R(rows),
+      body(static_cast<std::size_t>(cols) * rows),
+      occ(static_cast<std::size_t>(cols) * rows, 0),
+      freeCells(static_cast<std::size_t>(cols) * rows),
+      freeSlot(static_cast<std::size_t>(cols) * rows) {
+    reset(seed);
+}
+
+Game::Game(const Game& o)
+    : C(o.C), R(o.R), body(o.body), occ(o.occ), freeSlot(o.freeSlot) {
+    // Una copia de vector solo reserva su tamaño: releaseFree() realocaría al soltar la cola.
+    freeCells.reserve(occ.size());
+    freeCells = o.freeCells;
+    copyScalars(o);
+}
+
+Game& Game::operator=(const Game& o) {
+    if (this == &o) return *this;
+    C = o.C;
+    R = o.R;
+    body = o.body;
+    occ = o.occ;
+    freeCells.reserve(o.occ.size());
+    freeCells = o.freeCells;
+    freeSlot = o.freeSlot;
+    copyScalars(o);
+    return *this;
+}
+
+void Game::copyScalars(const Game& o) noexcept {
+    food        = o.food;
+    curDir      = o.curDir;
+    pendingDir  = o.pendingDir;
+    std::copy(std::begin(o.turns), std::end(o.turns), std::begin(turns));
+    turnHead    = o.turnHead;
+    turnCount   = o.turnCount;
+    over        = o.over;
+    win         = o.win;
+    points      = o.points;
+    borderMode  = o.borderMode;
+    rng         = o.rng;
+    episodeSeed = o.episodeSeed;
+    delta       = o.delta;
+    zhash       = o.zhash;
+    zhead       = o.zhead;
 }
 
 void Game::reset() {
-    body.clear();
+    reset(rng.next());
+}
+
+void Game::reset(std::uint64_t seed) {
+    episodeSeed = seed;
+    rng.reseed(seed);
     const int cx = C / 2, cy = R / 2;
-    body.push_back({cx - 2, cy});
-    body.push_back({cx - 1, cy});
-    body.push_back({cx,     cy});
-    curDir = pendingDir = Dir::Right;
+    const Cell start[3] = {{cx - 2, cy}, {cx - 1, cy}, {cx, cy}};
+    loadBody(start, Dir::Right);
+}
+
+void Game::loadBody(std::span<const Cell> cells, Dir d) {
+    body.clear();
+    zhash = zkey(Z_BORDER, static_cast<int>(borderMode)) ^ zkey(Z_DIR, static_cast<int>(d));
+    food = {-1, -1};
+    std::fill(occ.begin(), occ.end(), std::uint8_t{0});
+    freeCells.resize(occ.size());
+    for (int i = 0; i < static_cast<int>(freeCells.size()); ++i) freeCells[i] = freeSlot[i] = i;
+    for (const Cell& c : cells) pushHead(c);
+    zhead = zkey(Z_BODY, index(body.back()));
+    zhash ^= headMark(zhead);
+    curDir = pendingDir = d;
+    turnHead = turnCount = 0;
     over = false;
-    points = 0;
+    win  = false;
+    delta = TickDelta{};
+    points = static_cast<int>(cells.size()) > 3 ? static_cast<int>(cells.size()) - 3 : 0;
     spawnFood();
 }
 
 void Game::setPendingDir(Dir d) noexcept {
-    if (!isOpposite(d, curDir)) pendingDir = d;
+    const Dir follows = turnCount ? turns[(turnHead + turnCount - 1) % TURN_QUEUE] : curDir;
+    if (d == follows || isOpposite(d, follows) || turnCount == TURN_QUEUE) return;
+    turns[(turnHead + turnCount) % TURN_QUEUE] = d;
+    ++turnCount;
 }
 
 bool Game::isOpposite(Dir a, Dir b) noexcept {
@@ -50,8 +116,38 @@ bool Game::outOfBounds(const Cell& c) const noexcept {
 }
 
 bool Game::occupies(const Cell& c) const noexcept {
-    for (const auto& s : body) if (s == c) return true;
-    return false;
+    return occ[index(c)] != 0;
+}
+
+void Game::pushHead(const Cell& c) noexcept {
+    body.push_back(c);
+    const int i = index(c);
+    occ[i] = 1;
+    zhead = zkey(Z_BODY, i);
+    zhash ^= zhead;
+    takeFree(i);
+}
+
+void Game::popTail() noexcept {
+    const int i = index(body.front());
+    occ[i] = 0;
+    zhash ^= zkey(Z_BODY, i);
+    releaseFree(i);
+    body.pop_front();
+}
+
+void Game::takeFree(int idx) noexcept {
+    const int slot = freeSlot[idx];
+    const int last = freeCells.back();
+    freeCells[slot] = last;
+    freeSlot[last]  = slot;
+    freeCells.pop_back();
+    freeSlot[idx] = -1;
+}
+
+void Game::releaseFree(int idx) noexcept {
+    freeSlot[idx] = static_cast<int>(freeCells.size());
+    freeCells.push_back(idx); // capacidad reservada en el constructor: no realoca
 }
 
 Cell Game::nextHead() const noexcept {
@@ -63,27 +159,58 @@ Cell Game::nextHead() const noexcept {
 }
 
 void Game::spawnFood() {
-    // Simple y suficiente para grid mediana.
-    for (;;) {
-        Cell f{ std::rand() % C, std::rand() % R };
-        if (!occupies(f)) { food = f; return; }
+    zhash ^= foodKey();
+    if (freeCells.empty()) {
+        // Tablero lleno: no hay dónde poner comida.
+        food = {-1, -1};
+        win = over = true;
+        return;
     }
+    const int i = freeCells[rng.below(static_cast<std::uint32_t>(freeCells.size()))];
+    food = { i % C, i / C };
+    zhash ^= foodKey();
 }
 
-void Game::tick() {
-    if (over) return;
+const TickDelta& Game::tick() {
+    delta = TickDelta{};
+    if (over) return delta;
+
+    // Un giro por tick; sin giros se sigue recto.
+    pendingDir = curDir;
+    if (turnCount) {
+        pendingDir = turns[turnHead];
+        turnHead = (turnHead + 1) % TURN_QUEUE;
+        --turnCount;
+    }
+    delta.dir = pendingDir;
 
     const Cell h = nextHead();
-    if (borderMode == Border::Walls && outOfBounds(h)) { over = true; return; }
+    if (borderMode == Border::Walls && outOfBounds(h)) { over = delta.died = true; return delta; }
 
     const bool grow = (h == food);
-    const std::size_t limit = body.size() - (grow ? 0 : 1); // moverte a la antigua cola es legal si no creces
-    for (std::size_t i = 0; i < limit; ++i) {
-        if (body[i] == h) { over = true; return; }
-    }
+    // Moverte a la antigua cola es legal si no creces: se libera en este mismo tick.
+    if (occupies(h) && (grow || !(h == body.front()))) { over = delta.died = true; return delta; }
 
+    if (curDir != pendingDir) zhash ^= zkey(Z_DIR, static_cast<int>(curDir)) ^ zkey(Z_DIR, static_cast<int>(pendingDir));
     curDir = pendingDir;
-    body.push_back(h);
-    if (!grow) body.pop_front();
-    else { ++points; spawnFood(); }
+    if (!grow) {
+        delta.tailRemoved = true;
+        delta.tail = body.front();
+        popTail();
+    }
+    const std::uint64_t oldMark = headMark(zhead);
+    pushHead(h);
+    zhash ^= oldMark ^ headMark(zhead);
+    delta.moved = true;
+    delta.head = h;
+    if (grow) {
+        ++points;
+        delta.scoreDelta = 1;
+        delta.foodChanged = true;
+        delta.oldFood = food;
+        spawnFood();
+        delta.newFood = food;
+        delta.won = delta.died = win;
+    }
+    return delta;
 }
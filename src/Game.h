@@ -1,5 +1,9 @@
 #pragma once
-#include <deque>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "RingBuffer.h"
+#include "Rng.h"
 #include "Types.h"
 
 /**
@@ -7,6 +11,25 @@
  */
 enum class Dir { Up, Down, Left, Right };
 
+/**
+ * @brief Cambios que produjo un tick, para consumidores incrementales (render, registros).
+ *
+ * Un tick sin efecto (juego ya terminado) deja todos los flags a false.
+ */
+struct TickDelta {
+    bool moved       = false; ///< @brief La cabeza avanzó a head.
+    bool tailRemoved = false; ///< @brief Se liberó la celda tail (no hubo crecimiento).
+    bool foodChanged = false; ///< @brief La comida pasó de oldFood a newFood.
+    bool died        = false; ///< @brief El juego terminó en este tick (choque o victoria).
+    bool won         = false; ///< @brief El tablero quedó lleno en este tick.
+    int  scoreDelta  = 0;     ///< @brief Puntos ganados en este tick.
+    Dir  dir{};               ///< @brief Dirección con la que se intentó avanzar (si moved o died).
+    Cell head{};              ///< @brief Nueva cabeza.
+    Cell tail{};              ///< @brief Cola retirada.
+    Cell oldFood{};           ///< @brief Comida anterior.
+    Cell newFood{};           ///< @brief Comida nueva ({-1,-1} si no queda sitio).
+};
+
 /**
  * @brief Lógica pura de Snake sobre una grilla CxR, sin dependencias de OpenGL.
  *
@@ -14,6 +37,13 @@ enum class Dir { Up, Down, Left, Right };
  *  - Avance con paso fijo (tick).
  *  - Gestión de crecimiento, comida y colisiones.
  *  - Modos de borde (wrap / walls).
+ *
+ * Cada instancia tiene su propio generador (Rng): no hay estado global y un
+ * episodio se reproduce bit a bit a partir de su semilla (seed()).
+ *
+ * Mantiene además un hash Zobrist de la posición (hash()), actualizado en
+ * O(1) por tick. Las claves salen de mezclar (tipo, celda) con splitmix64 en
+ * vez de una tabla: no ocupan memoria y copiar un Game sigue igual de barato.
  */
 class Game {
 public:
@@ -24,25 +54,66 @@ public:
      * @brief Construye el juego para una grilla de cols x rows.
      * @param cols Columnas (C > 0)
      * @param rows Filas (R > 0)
+     * @param seed Semilla del primer episodio.
      */
-    Game(int cols, int rows);
+    Game(int cols, int rows, std::uint64_t seed = 0);
 
-    /// @brief Estado inicial: serpiente de 3, dirección derecha, puntuación 0 y comida nueva.
+    /**
+     * @brief Copia completa del estado (búsquedas, simulaciones).
+     *
+     * Entre tableros del mismo tamaño la asignación reutiliza la memoria del
+     * destino: clonar es copiar O(cols*rows) bytes, sin asignar. La copia
+     * reserva freeCells para el tablero entero, como el constructor, para que
+     * los ticks de la copia tampoco asignen.
+     */
+    Game(const Game& o);
+    Game& operator=(const Game& o);
+    Game(Game&&) noexcept = default;
+    Game& operator=(Game&&) noexcept = default;
+
+    /// @brief Nuevo episodio con una semilla sacada del propio generador (secuencia determinista).
     void reset();
 
-    /// @brief Solicita cambio de dirección (se aplica al inicio del próximo tick si no es 180º).
+    /// @brief Estado inicial: serpiente de 3, dirección derecha, puntuación 0 y comida nueva.
+    void reset(std::uint64_t seed);
+
+    /**
+     * @brief Carga una posición arbitraria (herramientas, benchmarks, análisis).
+     *
+     * Sustituye el cuerpo por cells (cola -> cabeza), fija la dirección d, vacía
+     * la cola de giros, pone la puntuación a size-3 y genera comida con el
+     * generador actual. Precondición: celdas dentro del tablero, distintas y
+     * consecutivas adyacentes; no se comprueba.
+     */
+    void loadBody(std::span<const Cell> cells, Dir d);
+
+    /**
+     * @brief Encola un giro; cada tick consume uno.
+     *
+     * Se valida contra la dirección a la que seguirá (el último giro encolado, o
+     * la actual si no hay ninguno): se ignoran los de 180º y los que no cambian
+     * nada. Con la cola llena (TURN_QUEUE) el giro se descarta.
+     */
     void setPendingDir(Dir d) noexcept;
 
+    /// @brief Capacidad de la cola de giros.
+    static constexpr int TURN_QUEUE = 3;
+
     /// @brief Avanza un paso lógico: aplica dirección, mueve, crece y evalúa colisiones.
-    void tick();
+    /// @return Cambios producidos (también disponibles en lastDelta()).
+    const TickDelta& tick();
 
     // --- Consultas (O(1)) ---
-    /// @brief Cuerpo completo (cabeza = back()).
-    const std::deque<Cell>& snake() const noexcept { return body; }
+    /// @brief Cuerpo completo (cola = front(), cabeza = back()).
+    const RingBuffer<Cell>& snake() const noexcept { return body; }
     /// @brief Dirección actual aplicada.
     Dir dir() const noexcept { return curDir; }
+    /// @brief Giros encolados pendientes de aplicar.
+    int queuedTurns() const noexcept { return turnCount; }
     /// @brief Indicador de fin de juego.
     bool gameOver() const noexcept { return over; }
+    /// @brief Victoria: la serpiente llena el tablero (implica gameOver()).
+    bool gameWon() const noexcept { return win; }
     /// @brief Tamaño en columnas.
     int cols() const noexcept { return C; }
     /// @brief Tamaño en filas.
@@ -51,25 +122,80 @@ public:
     const Cell& foodCell() const noexcept { return food; }
     /// @brief Puntuación actual (nº de comidas).
     int score() const noexcept { return points; }
+    /// @brief Semilla del episodio actual.
+    std::uint64_t seed() const noexcept { return episodeSeed; }
+    /// @brief Cambios del último tick (vacío tras reset()).
+    const TickDelta& lastDelta() const noexcept { return delta; }
+    /// @brief ¿La serpiente ocupa la celda? O(1) vía mapa de ocupación.
+    bool occupies(const Cell& c) const noexcept;
+
+    /**
+     * @brief Hash Zobrist de la posición: celdas del cuerpo, cabeza, comida,
+     * dirección y modo de borde (XOR de una clave por elemento).
+     *
+     * Dos posiciones iguales dan el mismo hash sea cual sea la partida que las
+     * produjo. No incluye giros encolados, puntuación ni generador.
+     */
+    std::uint64_t hash() const noexcept { return zhash; }
+
+    /// @brief Estado del generador de la comida: decide dónde aparecerán las próximas.
+    const Rng& rngState() const noexcept { return rng; }
+    /// @brief Sustituye el generador (p. ej. en una copia, para muestrear otras comidas futuras).
+    void setRngState(const Rng& r) noexcept { rng = r; }
 
     /// @brief Fija el modo de borde (wrap/walls).
-    void setBorderMode(Border m) noexcept { borderMode = m; }
+    void setBorderMode(Border m) noexcept {
+        zhash ^= zkey(Z_BORDER, static_cast<int>(borderMode)) ^ zkey(Z_BORDER, static_cast<int>(m));
+        borderMode = m;
+    }
     /// @brief Recupera el modo de borde.
     Border borderModeMode() const noexcept { return borderMode; }
 
 private:
+    friend struct GameProbe; ///< @brief Acceso a internos para benchmarks (tools/).
+
     // --- Estado invariante de tablero ---
     int C;                  ///< @brief Columnas.
     int R;                  ///< @brief Filas.
 
     // --- Estado dinámico de juego ---
-    std::deque<Cell> body;  ///< @brief Cuerpo: cola=front(), cabeza=back().
+    RingBuffer<Cell> body;  ///< @brief Cuerpo (capacidad CxR): cola=front(), cabeza=back().
+    std::vector<std::uint8_t> occ; ///< @brief Mapa de ocupación CxR (1 = cuerpo), sincronizado con body.
+    std::vector<int> freeCells;    ///< @brief Índices de celdas libres (denso, orden arbitrario).
+    std::vector<int> freeSlot;     ///< @brief Celda -> posición en freeCells (-1 si ocupada).
     Cell food{};            ///< @brief Posición de la comida.
     Dir curDir{};           ///< @brief Dirección aplicada.
-    Dir pendingDir{};       ///< @brief Dirección solicitada (se valida por tick).
+    Dir pendingDir{};       ///< @brief Dirección del tick en curso.
+    Dir turns[TURN_QUEUE]{}; ///< @brief Cola circular de giros pendientes.
+    int turnHead  = 0;      ///< @brief Primer giro de la cola.
+    int turnCount = 0;      ///< @brief Giros en cola.
     bool over = false;      ///< @brief Fin de juego.
+    bool win  = false;      ///< @brief Tablero completo.
     int points = 0;         ///< @brief Puntuación.
     Border borderMode = Border::Wrap; ///< @brief Modo de borde.
+    Rng rng;                ///< @brief Generador propio (comida).
+    std::uint64_t episodeSeed = 0; ///< @brief Semilla con la que empezó el episodio.
+    TickDelta delta{};      ///< @brief Cambios del último tick.
+    std::uint64_t zhash = 0; ///< @brief Hash Zobrist de la posición (ver hash()).
+    std::uint64_t zhead = 0; ///< @brief Clave de cuerpo de la cabeza (su marca de cabeza es headMark(zhead)).
+
+    /// @brief Copia de todo lo que no son tablas (al añadir un campo, copiarlo aquí).
+    void copyScalars(const Game& o) noexcept;
+
+    /// @brief Tipos de clave Zobrist.
+    enum : std::uint64_t { Z_BODY = 1, Z_FOOD, Z_DIR, Z_BORDER };
+
+    /// @brief Marca de cabeza derivada de la clave de cuerpo: un tick calcula solo dos claves.
+    static std::uint64_t headMark(std::uint64_t bodyKey) noexcept { return (bodyKey << 32) | (bodyKey >> 32); }
+
+    /// @brief Clave Zobrist del elemento i (celda o valor de enum) de un tipo.
+    static std::uint64_t zkey(std::uint64_t kind, int i) noexcept {
+        std::uint64_t x = (kind << 32) | static_cast<std::uint32_t>(i);
+        return Rng::splitmix64(x);
+    }
+
+    /// @brief Clave de la comida actual (0 si no hay: tablero lleno).
+    std::uint64_t foodKey() const noexcept { return food.x >= 0 ? zkey(Z_FOOD, index(food)) : 0; }
 
     // --- Utilidades internas ---
     /// @brief ¿Son opuestas? (bloquea giro 180º).
@@ -84,12 +210,24 @@ private:
     /// @brief ¿Está fuera de límites?
     bool outOfBounds(const Cell& c) const noexcept;
 
-    /// @brief ¿La serpiente ocupa la celda?
-    bool occupies(const Cell& c) const noexcept;
+    /// @brief Índice lineal de una celda dentro del tablero (y*C + x).
+    int index(const Cell& c) const noexcept { return c.y * C + c.x; }
+
+    /// @brief Inserta la nueva cabeza y marca su celda como ocupada.
+    void pushHead(const Cell& c) noexcept;
+
+    /// @brief Retira la cola y libera su celda.
+    void popTail() noexcept;
+
+    /// @brief Saca una celda del conjunto libre (swap con el último, O(1)).
+    void takeFree(int idx) noexcept;
+
+    /// @brief Devuelve una celda al conjunto libre (O(1)).
+    void releaseFree(int idx) noexcept;
 
     /// @brief Nueva cabeza según pendingDir y modo de borde.
     Cell nextHead() const noexcept;
 
-    /// @brief Genera comida en celda libre.
+    /// @brief Genera comida en una celda libre uniforme (O(1)); si no queda ninguna, victoria.
     void spawnFood();
 };
@@ -0,0 +1,153 @@
+#include "GameBatch.h"
+#include <algorithm> // fill
+#include <chrono>
+
+namespace {
+    constexpr int DX[4] = { 0, 0, -1, 1 }; // Up, Down, Left, Right
+    constexpr int DY[4] = {-1, 1,  0, 0 };
+
+    // Up/Down = 0/1 y Left/Right = 2/3: opuestas difieren solo en el bit bajo.
+    bool isOpposite(Dir a, Dir b) noexcept {
+        return (static_cast<int>(a) ^ static_cast<int>(b)) == 1;
+    }
+
+    std::uint8_t mark(Dir d) noexcept { return static_cast<std::uint8_t>(1 + static_cast<int>(d)); }
+} // namespace
+
+GameBatch::GameBatch(std::size_t count, int cols, int rows, std::uint64_t seed)
+    : N(count), C(cols), R(rows), cells(static_cast<std::size_t>(cols) * rows),
+      headX(count), headY(count), tailX(count), tailY(count),
+      dirs(count), lengths(count), points(count), steps(count), food(count),
+      over(count), win(count), freeCount(count), rngs(count), seeds(count),
+      grid(count * cells), freeCells(count * cells), freeSlot(count * cells) {
+    // El primer episodio usa la semilla de construcción; los siguientes, una nueva del propio generador.
+    for (std::size_t b = 0; b < N; ++b) {
+        seeds[b] = seed + b;
+        rngs[b].reseed(seeds[b]);
+        init(b);
+    }
+}
+
+void GameBatch::resetAll() {
+    for (std::size_t b = 0; b < N; ++b) reset(b);
+}
+
+void GameBatch::reset(std::size_t b) {
+    seeds[b] = rngs[b].next();
+    rngs[b].reseed(seeds[b]);
+    init(b);
+}
+
+void GameBatch::init(std::size_t b) noexcept {
+    const std::size_t base = b * cells;
+    std::fill(grid.begin() + base, grid.begin() + base + cells, std::uint8_t{0});
+    for (int i = 0; i < static_cast<int>(cells); ++i) freeCells[base + i] = freeSlot[base + i] = i;
+    freeCount[b] = static_cast<int>(cells);
+
+    // Mismo estado y mismo orden de altas en el conjunto libre que Game::reset().
+    const int cx = C / 2, cy = R / 2;
+    for (int k = 2; k >= 0; --k) {
+        const int idx = cy * C + (cx - k);
+        grid[base + idx] = mark(Dir::Right);
+        takeFree(b, idx);
+    }
+    headX[b] = cx;     headY[b] = cy;
+    tailX[b] = cx - 2; tailY[b] = cy;
+    dirs[b] = Dir::Right;
+    lengths[b] = 3;
+    points[b] = 0;
+    steps[b] = 0;
+    over[b] = win[b] = 0;
+    spawnFood(b);
+}
+
+Cell GameBatch::foodCell(std::size_t b) const noexcept {
+    const int f = food[b];
+    return f < 0 ? Cell{-1, -1} : Cell{ f % C, f / C };
+}
+
+void GameBatch::takeFree(std::size_t b, int idx) noexcept {
+    const std::size_t base = b * cells;
+    const int slot = freeSlot[base + idx];
+    const int last = freeCells[base + --freeCount[b]];
+    freeCells[base + slot] = last;
+    freeSlot[base + last]  = slot;
+    freeSlot[base + idx]   = -1;
+}
+
+void GameBatch::releaseFree(std::size_t b, int idx) noexcept {
+    const std::size_t base = b * cells;
+    freeSlot[base + idx] = freeCount[b];
+    freeCells[base + freeCount[b]++] = idx;
+}
+
+void GameBatch::spawnFood(std::size_t b) noexcept {
+    if (freeCount[b] == 0) {
+        food[b] = -1;
+        win[b] = over[b] = 1;
+        return;
+    }
+    const std::uint32_t k = rngs[b].below(static_cast<std::uint32_t>(freeCount[b]));
+    food[b] = freeCells[b * cells + k];
+}
+
+bool GameBatch::stepOne(std::size_t b, Dir action) noexcept {
+    if (over[b]) return false;
+    ++steps[b];
+
+    // setPendingDir + tick: un giro de 180º se ignora y se sigue recto.
+    const Dir d = isOpposite(action, dirs[b]) ? dirs[b] : action;
+    const int di = static_cast<int>(d);
+    int x = headX[b] + DX[di];
+    int y = headY[b] + DY[di];
+    if (borderMode == Game::Border::Wrap) {
+        if (x < 0)  x = C - 1;
+        if (x >= C) x = 0;
+        if (y < 0)  y = R - 1;
+        if (y >= R) y = 0;
+    } else if (x < 0 || x >= C || y < 0 || y >= R) {
+        over[b] = 1;
+        return true;
+    }
+
+    const std::size_t base = b * cells;
+    const int h = y * C + x;
+    const int t = tailY[b] * C + tailX[b];
+    const bool grow = (h == food[b]);
+    if (grid[base + h] != 0 && (grow || h != t)) { over[b] = 1; return true; }
+
+    dirs[b] = d;
+    if (!grow) {
+        // La cola sigue el enlace de su celda hacia el siguiente segmento.
+        const int td = grid[base + t] - 1;
+        grid[base + t] = 0;
+        releaseFree(b, t);
+        // El cuerpo nunca cruza una pared, así que el wrap es correcto en ambos modos.
+        int tx = tailX[b] + DX[td], ty = tailY[b] + DY[td];
+        if (tx < 0) tx = C - 1; else if (tx >= C) tx = 0;
+        if (ty < 0) ty = R - 1; else if (ty >= R) ty = 0;
+        tailX[b] = tx; tailY[b] = ty;
+    }
+    grid[base + headY[b] * C + headX[b]] = mark(d);
+    grid[base + h] = mark(d);
+    takeFree(b, h);
+    headX[b] = x; headY[b] = y;
+    if (grow) { ++lengths[b]; ++points[b]; spawnFood(b); }
+    return true;
+}
+
+std::size_t GameBatch::stepRange(std::size_t begin, std::size_t end, std::span<const Dir> actions) noexcept {
+    std::size_t live = 0;
+    for (std::size_t b = begin; b < end; ++b) live += stepOne(b, actions[b]) ? 1 : 0;
+    return live;
+}
+
+void GameBatch::stepAll(std::span<const Dir> actions) {
+    const auto t0 = std::chrono::steady_clock::now();
+    ticks += stepRange(0, N, actions);
+    stepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+double GameBatch::ticksPerSecond() const noexcept {
+    return stepSeconds > 0.0 ? static_cast<double>(ticks) / stepSeconds : 0.0;
+}
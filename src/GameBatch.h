@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Game.h"
+#include "Rng.h"
+
+/**
+ * @brief Motor sin ventana que simula N tableros CxR a la vez en layout SoA.
+ *
+ * Cada tablero sigue exactamente las reglas de Game::tick (giro de 180º
+ * ignorado, paso a la antigua cola legal si no crece, comida uniforme sobre
+ * celdas libres, victoria con el tablero lleno). El estado se guarda por
+ * columnas (cabezas, colas, direcciones, longitudes, comida, flags) para que
+ * stepAll() recorra memoria contigua.
+ *
+ * El cuerpo no se almacena como lista: cada celda ocupada de la rejilla guarda
+ * la dirección hacia el siguiente segmento, así que la rejilla es a la vez el
+ * mapa de ocupación y el enlace cola -> cabeza.
+ *
+ * El tablero b reproduce bit a bit a Game(cols, rows, seed(b)) con las mismas
+ * acciones, incluidos los reset() sucesivos.
+ */
+class GameBatch {
+public:
+    /**
+     * @brief Construye count tableros de cols x rows.
+     * @param seed Semilla base; el tablero b empieza con seed + b.
+     */
+    GameBatch(std::size_t count, int cols, int rows, std::uint64_t seed = 0);
+
+    /// @brief Reinicia todos los tableros al estado inicial de Game::reset().
+    void resetAll();
+    /// @brief Reinicia un tablero con una semilla nueva sacada de su propio generador.
+    void reset(std::size_t b);
+
+    /**
+     * @brief Avanza un tick en todos los tableros.
+     * @param actions Una dirección por tablero (equivale a setPendingDir + tick).
+     */
+    void stepAll(std::span<const Dir> actions);
+
+    /**
+     * @brief Avanza un tick los tableros [begin, end) sin tocar contadores compartidos.
+     * @param actions Indexado por tablero (no por posición dentro del rango).
+     * @return Nº de tableros vivos que han avanzado.
+     */
+    std::size_t stepRange(std::size_t begin, std::size_t end, std::span<const Dir> actions) noexcept;
+
+    /// @brief Fija el modo de borde de todos los tableros.
+    void setBorderMode(Game::Border m) noexcept { borderMode = m; }
+    /// @brief Recupera el modo de borde.
+    Game::Border borderModeMode() const noexcept { return borderMode; }
+
+    // --- Consultas por tablero (O(1)) ---
+    std::size_t size() const noexcept { return N; }
+    int cols() const noexcept { return C; }
+    int rows() const noexcept { return R; }
+    Cell head(std::size_t b) const noexcept { return {headX[b], headY[b]}; }
+    Cell tail(std::size_t b) const noexcept { return {tailX[b], tailY[b]}; }
+    Dir  dir(std::size_t b) const noexcept { return dirs[b]; }
+    int  length(std::size_t b) const noexcept { return lengths[b]; }
+    int  score(std::size_t b) const noexcept { return points[b]; }
+    std::uint64_t seed(std::size_t b) const noexcept { return seeds[b]; }
+    /// @brief Ticks vividos en el episodio actual (incluye el tick de la muerte).
+    int  episodeTicks(std::size_t b) const noexcept { return steps[b]; }
+    Cell foodCell(std::size_t b) const noexcept;
+    bool gameOver(std::size_t b) const noexcept { return over[b] != 0; }
+    bool gameWon(std::size_t b) const noexcept { return win[b] != 0; }
+    bool occupies(std::size_t b, const Cell& c) const noexcept {
+        return grid[b * cells + (c.y * C + c.x)] != 0;
+    }
+
+    // --- Rendimiento ---
+    /// @brief Ticks de tablero simulados (solo tableros vivos) desde la construcción.
+    std::uint64_t totalTicks() const noexcept { return ticks; }
+    /// @brief Ticks de tablero por segundo medidos dentro de stepAll().
+    double ticksPerSecond() const noexcept;
+
+private:
+    // --- Geometría compartida ---
+    std::size_t N;      ///< @brief Nº de tableros.
+    int C;              ///< @brief Columnas.
+    int R;              ///< @brief Filas.
+    std::size_t cells;  ///< @brief C*R.
+    Game::Border borderMode = Game::Border::Wrap;
+
+    // --- Estado SoA (índice = tablero) ---
+    std::vector<int> headX, headY;        ///< @brief Cabezas.
+    std::vector<int> tailX, tailY;        ///< @brief Colas.
+    std::vector<Dir> dirs;                ///< @brief Dirección aplicada.
+    std::vector<int> lengths;             ///< @brief Longitud del cuerpo.
+    std::vector<int> points;              ///< @brief Puntuación.
+    std::vector<int> steps;               ///< @brief Ticks del episodio actual.
+    std::vector<int> food;                ///< @brief Índice de celda de comida (-1 = ninguna).
+    std::vector<std::uint8_t> over;       ///< @brief Fin de juego.
+    std::vector<std::uint8_t> win;        ///< @brief Tablero completo.
+    std::vector<int> freeCount;           ///< @brief Nº de celdas libres.
+    std::vector<Rng> rngs;                ///< @brief Generador por tablero.
+    std::vector<std::uint64_t> seeds;     ///< @brief Semilla del episodio actual.
+
+    // --- Rejillas (índice = tablero * cells + celda) ---
+    std::vector<std::uint8_t> grid;       ///< @brief 0 = libre; si no, 1 + Dir hacia el siguiente segmento.
+    std::vector<int> freeCells;           ///< @brief Celdas libres por tablero (denso).
+    std::vector<int> freeSlot;            ///< @brief Celda -> posición en freeCells (-1 si ocupada).
+
+    // --- Medición ---
+    std::uint64_t ticks = 0;
+    double stepSeconds = 0.0;
+
+    void init(std::size_t b) noexcept;
+    bool stepOne(std::size_t b, Dir action) noexcept;
+    void takeFree(std::size_t b, int idx) noexcept;
+    void releaseFree(std::size_t b, int idx) noexcept;
+    void spawnFood(std::size_t b) noexcept;
+};
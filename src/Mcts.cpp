@@ -0,0 +1,205 @@
+#include "Mcts.h"
+#include <algorithm> // max
+#include <chrono>
+#include <cmath>     // log, pow, sqrt
+
+namespace {
+    constexpr Dir DIRS[4] = {Dir::Up, Dir::Down, Dir::Left, Dir::Right};
+
+    bool isReverse(Dir a, Dir b) noexcept {
+        return (a == Dir::Up && b == Dir::Down) || (a == Dir::Down && b == Dir::Up)
+            || (a == Dir::Left && b == Dir::Right) || (a == Dir::Right && b == Dir::Left);
+    }
+
+    std::int64_t steadyNs() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// @brief ¿Avanzar en d deja a g con vida este tick? (mismas reglas que Game::tick).
+    bool survives(const Game& g, Dir d) noexcept {
+        Cell h = g.snake().back();
+        switch (d) {
+            case Dir::Up:    --h.y; break;
+            case Dir::Down:  ++h.y; break;
+            case Dir::Left:  --h.x; break;
+            case Dir::Right: ++h.x; break;
+        }
+        if (g.borderModeMode() == Game::Border::Wrap) {
+            h.x = (h.x + g.cols()) % g.cols();
+            h.y = (h.y + g.rows()) % g.rows();
+        } else if (h.x < 0 || h.y < 0 || h.x >= g.cols() || h.y >= g.rows()) {
+            return false;
+        }
+        return !g.occupies(h) || (h == g.snake().front() && !(h == g.foodCell()));
+    }
+} // namespace
+
+MctsAgent::MctsAgent(int cols, int rows, ThreadPool& p, const MctsConfig& c)
+    : pool(p), cfg(c), nodes(std::make_unique<Node[]>(std::max<std::uint32_t>(c.maxNodes, 1 + ACTIONS))) {
+    cfg.maxNodes = std::max<std::uint32_t>(cfg.maxNodes, 1 + ACTIONS);
+    // Mezcla con una constante propia: la semilla suele ser también la del Game que se juega.
+    std::uint64_t mixed = cfg.seed ^ 0xBB67AE8584CAA73Bull;
+    Rng stream(Rng::splitmix64(mixed));
+    for (unsigned i = 0; i < pool.size(); ++i) {
+        auto w = std::make_unique<Worker>(cols, rows);
+        w->rng = stream;
+        w->path.reserve(static_cast<std::size_t>(cols) * rows);
+        stream.jump();
+        workers.push_back(std::move(w));
+    }
+}
+
+void MctsAgent::resetTree(Dir d) noexcept {
+    Node& root = nodes[0];
+    root.visits.store(0, std::memory_order_relaxed);
+    root.value.store(0.0, std::memory_order_relaxed);
+    root.children.store(0, std::memory_order_relaxed);
+    root.expanding.store(false, std::memory_order_relaxed);
+    root.dir = d;
+    used.store(1, std::memory_order_relaxed);
+}
+
+bool MctsAgent::expand(std::uint32_t n) noexcept {
+    Node& parent = nodes[n];
+    if (parent.expanding.exchange(true, std::memory_order_acq_rel)) return true; // lo hace otro hilo
+    const std::uint32_t first = used.fetch_add(ACTIONS, std::memory_order_relaxed);
+    if (first + ACTIONS > cfg.maxNodes) return false; // se queda como hoja para siempre
+
+    std::uint32_t k = first;
+    for (const Dir d : DIRS) {
+        if (isReverse(d, parent.dir)) continue;
+        Node& c = nodes[k++];
+        c.visits.store(0, std::memory_order_relaxed);
+        c.value.store(0.0, std::memory_order_relaxed);
+        c.children.store(0, std::memory_order_relaxed);
+        c.expanding.store(false, std::memory_order_relaxed);
+        c.dir = d;
+    }
+    parent.children.store(first, std::memory_order_release);
+    return true;
+}
+
+std::uint32_t MctsAgent::select(std::uint32_t n) const noexcept {
+    const std::uint32_t first = nodes[n].children.load(std::memory_order_acquire);
+    const double logN = std::log(std::max(1, nodes[n].visits.load(std::memory_order_relaxed)));
+    std::uint32_t best = first;
+    double bestScore = -1.0;
+    for (std::uint32_t k = first; k < first + ACTIONS; ++k) {
+        const std::int32_t v = nodes[k].visits.load(std::memory_order_relaxed);
+        if (v <= 0) return k;
+        const double q = nodes[k].value.load(std::memory_order_relaxed) / v;
+        const double score = q + cfg.exploration * std::sqrt(logN / v);
+        if (score > bestScore) {
+            bestScore = score;
+            best = k;
+        }
+    }
+    return best;
+}
+
+bool MctsAgent::iterate(Worker& w, const Game& root) {
+    Game& sim = w.sim;
+    sim = root;
+    sim.setRngState(Rng(w.rng.next()));
+    const int score0 = root.score();
+    int t = 0;
+    int firstEat = -1;
+    const auto step = [&](Dir d) {
+        sim.setPendingDir(d);
+        sim.tick();
+        ++t;
+        if (firstEat < 0 && sim.score() > score0) firstEat = t;
+    };
+
+    // Selección: baja por el árbol apuntando pérdidas virtuales.
+    const int vl = cfg.virtualLoss;
+    w.path.clear();
+    std::uint32_t n = 0;
+    w.path.push_back(n);
+    nodes[n].visits.fetch_add(vl, std::memory_order_relaxed);
+    while (!sim.gameOver() && nodes[n].children.load(std::memory_order_acquire) != 0) {
+        n = select(n);
+        nodes[n].visits.fetch_add(vl, std::memory_order_relaxed);
+        w.path.push_back(n);
+        step(nodes[n].dir);
+    }
+
+    // Expansión: una hoja ya visitada antes crea sus hijos y se baja a uno.
+    bool room = true;
+    if (!sim.gameOver() && nodes[n].visits.load(std::memory_order_relaxed) > vl) {
+        room = expand(n);
+        if (room && nodes[n].children.load(std::memory_order_acquire) != 0) {
+            n = select(n);
+            nodes[n].visits.fetch_add(vl, std::memory_order_relaxed);
+            w.path.push_back(n);
+            step(nodes[n].dir);
+        }
+    }
+
+    // Simulación: al azar entre las jugadas que no chocan en el acto.
+    for (int i = 0; i < cfg.rolloutDepth && !sim.gameOver(); ++i) {
+        Dir options[3];
+        int count = 0;
+        for (const Dir d : DIRS) {
+            if (!isReverse(d, sim.dir()) && survives(sim, d)) options[count++] = d;
+        }
+        step(count ? options[w.rng.below(static_cast<std::uint32_t>(count))] : sim.dir());
+    }
+
+    const bool alive = !sim.gameOver() || sim.gameWon();
+    const double reward = (alive ? 0.5 : 0.0) + (firstEat > 0 ? 0.5 * std::pow(cfg.discount, firstEat - 1) : 0.0);
+
+    // Retropropagación: cada pérdida virtual se cambia por la visita real.
+    for (const std::uint32_t p : w.path) {
+        nodes[p].visits.fetch_add(1 - vl, std::memory_order_relaxed);
+        nodes[p].value.fetch_add(reward, std::memory_order_relaxed);
+    }
+    return room;
+}
+
+void MctsAgent::searchLoop(Worker& w, const Game& root, std::int64_t deadlineNs) {
+    while (steadyNs() < deadlineNs) {
+        const bool room = iterate(w, root);
+        ++w.rollouts;
+        if (!room) break;
+    }
+}
+
+Dir MctsAgent::decide(const Game& g) {
+    const auto t0 = std::chrono::steady_clock::now();
+    resetTree(g.dir());
+    stats = MctsStats{};
+    if (g.gameOver()) return g.dir();
+
+    expand(0);
+    const std::int64_t deadline = steadyNs() + cfg.budgetNs;
+    // Una tarea por trabajador; cada una usa su Worker (por tarea, no por hilo: así da igual quién la robe).
+    for (auto& w : workers) {
+        Worker* wp = w.get();
+        wp->rollouts = 0;
+        pool.submit([this, wp, &g, deadline](unsigned) { searchLoop(*wp, g, deadline); });
+    }
+    pool.wait();
+
+    const std::uint32_t first = nodes[0].children.load(std::memory_order_acquire);
+    Dir best = nodes[first].dir;
+    std::int32_t bestVisits = -1;
+    for (std::uint32_t k = first; k < first + ACTIONS; ++k) {
+        const std::int32_t v = nodes[k].visits.load(std::memory_order_relaxed);
+        if (v > bestVisits) {
+            bestVisits = v;
+            best = nodes[k].dir;
+        }
+    }
+
+    for (const auto& w : workers) stats.rollouts += w->rollouts;
+    stats.nodes = std::min(used.load(std::memory_order_relaxed), cfg.maxNodes);
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return best;
+}
+
+void MctsAgent::drive(Game& g) {
+    if (g.gameOver() || g.queuedTurns() != 0) return;
+    g.setPendingDir(decide(g));
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Game.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Parámetros de MctsAgent.
+ */
+struct MctsConfig {
+    std::int64_t budgetNs = 10'000'000; ///< @brief Tiempo de búsqueda por jugada (ns).
+    std::uint32_t maxNodes = 1u << 18;  ///< @brief Capacidad del pool de nodos (la búsqueda para al llenarse).
+    int rolloutDepth = 64;              ///< @brief Ticks máximos de cada simulación desde la hoja.
+    double exploration = 0.7;           ///< @brief Constante c de UCT.
+    int virtualLoss = 3;                ///< @brief Visitas perdidas que apunta cada hilo al bajar por un nodo.
+    double discount = 0.98;             ///< @brief Por tick de espera hasta la primera comida.
+    std::uint64_t seed = 1;             ///< @brief Semilla de los flujos por trabajador.
+};
+
+/**
+ * @brief Resultado de la última búsqueda.
+ */
+struct MctsStats {
+    std::uint64_t rollouts = 0; ///< @brief Simulaciones completadas.
+    std::uint32_t nodes = 0;    ///< @brief Nodos usados del pool.
+    double seconds = 0.0;       ///< @brief Tiempo de pared.
+
+    double rolloutsPerSecond() const noexcept { return seconds > 0.0 ? double(rollouts) / seconds : 0.0; }
+};
+
+/**
+ * @brief Jugador por búsqueda de Monte Carlo en árbol (UCT) con paralelismo de árbol.
+ *
+ * Todos los trabajadores del ThreadPool comparten un árbol de nodos atómicos
+ * sin locks. La pérdida virtual aparta a los demás hilos de la rama que uno
+ * está recorriendo: al bajar suma virtualLoss visitas sin valor y al volver
+ * las cambia por la visita real.
+ *
+ * La comida es aleatoria, así que el árbol es de bucle abierto: un nodo es
+ * una secuencia de jugadas, no una posición. Cada iteración copia la
+ * posición raíz en el Game del trabajador, le pone un generador propio (así
+ * muestrea dónde aparece la comida) y aplica las jugadas del camino. La
+ * simulación sigue una política aleatoria que evita choques inmediatos. La
+ * recompensa en [0, 1] vale 0.5 por sobrevivir más 0.5 · discount^t si come
+ * (t = ticks hasta la primera comida).
+ *
+ * Los nodos salen de un pool fijo reservado en el constructor (reserva por
+ * incremento atómico, se vacía en cada búsqueda) y cada trabajador tiene su
+ * Game y su camino: la búsqueda no asigna memoria.
+ */
+class MctsAgent {
+public:
+    /// @param pool Trabajadores de la búsqueda (el agente no es su dueño).
+    MctsAgent(int cols, int rows, ThreadPool& pool, const MctsConfig& cfg = {});
+
+    /// @brief Busca durante budgetNs y devuelve la jugada más visitada desde g.
+    Dir decide(const Game& g);
+
+    /// @brief Si g sigue en juego y no hay giros encolados, encola decide(g).
+    void drive(Game& g);
+
+    /// @brief Estadísticas de la última decide().
+    const MctsStats& lastStats() const noexcept { return stats; }
+
+private:
+    static constexpr int ACTIONS = 3; ///< @brief Jugadas por nodo: las que no son giro de 180º.
+
+    struct Node {
+        std::atomic<std::int32_t> visits{0};   ///< @brief Incluye las pérdidas virtuales en curso.
+        std::atomic<double> value{0.0};        ///< @brief Suma de recompensas.
+        std::atomic<std::uint32_t> children{0}; ///< @brief Primero de ACTIONS hijos seguidos (0 = hoja).
+        std::atomic<bool> expanding{false};    ///< @brief Un hilo está creando los hijos.
+        Dir dir = Dir::Right;                  ///< @brief Jugada que lleva a este nodo.
+    };
+
+    /// @brief Estado de un trabajador (alineado para no compartir línea de caché).
+    struct alignas(64) Worker {
+        explicit Worker(int cols, int rows) : sim(cols, rows) {}
+        Game sim;
+        Rng rng;
+        std::vector<std::uint32_t> path;
+        std::uint64_t rollouts = 0;
+    };
+
+    ThreadPool& pool;
+    MctsConfig cfg;
+    std::unique_ptr<Node[]> nodes;
+    std::atomic<std::uint32_t> used{0};
+    std::vector<std::unique_ptr<Worker>> workers;
+    MctsStats stats;
+
+    /// @brief Deja la raíz (nodo 0) sola, llegando con la dirección d.
+    void resetTree(Dir d) noexcept;
+
+    /// @brief Crea los hijos de n si nadie lo está haciendo. @return false si el pool está lleno.
+    bool expand(std::uint32_t n) noexcept;
+
+    /// @brief Hijo de n con mejor UCT (con pérdidas virtuales).
+    std::uint32_t select(std::uint32_t n) const noexcept;
+
+    /// @brief Iteraciones de un trabajador hasta deadlineNs o hasta llenar el pool.
+    void searchLoop(Worker& w, const Game& root, std::int64_t deadlineNs);
+
+    /// @brief Una iteración: selección, expansión, simulación y retropropagación.
+    /// @return false si el pool se llenó.
+    bool iterate(Worker& w, const Game& root);
+};
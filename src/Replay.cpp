@@ -0,0 +1,204 @@
+#include "Replay.h"
+#include <algorithm> // min
+#include <cstring> // memcmp
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric> // lcm
+
+namespace {
+    constexpr char MAGIC[4] = {'S', 'N', 'K', 'R'};
+    constexpr std::uint8_t VERSION = 1;
+
+    void putVarint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+        while (v >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(v));
+    }
+
+    /// @brief Lector secuencial con control de límites.
+    struct Reader {
+        const std::uint8_t* p;
+        const std::uint8_t* end;
+        bool ok = true;
+
+        std::uint8_t byte() {
+            if (p == end) { ok = false; return 0; }
+            return *p++;
+        }
+        std::uint64_t varint() {
+            std::uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                const std::uint8_t b = byte();
+                v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+    };
+} // namespace
+
+// ---------------- Replay ----------------
+
+void Replay::encode(std::vector<std::uint8_t>& out) const {
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    out.push_back(VERSION);
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(seed >> (8 * i)));
+    putVarint(out, static_cast<std::uint64_t>(cols));
+    putVarint(out, static_cast<std::uint64_t>(rows));
+    out.push_back(static_cast<std::uint8_t>(border));
+
+    putVarint(out, events.size());
+    std::uint64_t prev = 0;
+    for (const auto& e : events) {
+        putVarint(out, ((e.tick - prev) << 3) | e.code);
+        prev = e.tick;
+    }
+
+    putVarint(out, endTick);
+    putVarint(out, static_cast<std::uint64_t>(score));
+    putVarint(out, static_cast<std::uint64_t>(length));
+    out.push_back(static_cast<std::uint8_t>((died ? 1 : 0) | (won ? 2 : 0)));
+}
+
+bool Replay::decode(const std::uint8_t* data, std::size_t size, std::uint64_t maxCells) {
+    Reader r{data, data + size};
+    if (size < 5 || std::memcmp(data, MAGIC, 4) != 0 || data[4] != VERSION) return false;
+    r.p += 5;
+
+    seed = 0;
+    for (int i = 0; i < 8; ++i) seed |= static_cast<std::uint64_t>(r.byte()) << (8 * i);
+    const std::uint64_t c = r.varint();
+    const std::uint64_t rw = r.varint();
+    const std::uint64_t side = std::min<std::uint64_t>(maxCells, std::numeric_limits<int>::max());
+    if (c > side || rw > side) return false;
+    cols = static_cast<int>(c);
+    rows = static_cast<int>(rw);
+    const std::uint8_t b = r.byte();
+    border = (b == static_cast<std::uint8_t>(Game::Border::Walls)) ? Game::Border::Walls : Game::Border::Wrap;
+
+    const std::uint64_t count = r.varint();
+    if (!r.ok || count > size) return false; // cada evento ocupa al menos un byte
+    events.clear();
+    events.reserve(static_cast<std::size_t>(count));
+    std::uint64_t tick = 0;
+    for (std::uint64_t i = 0; i < count && r.ok; ++i) {
+        const std::uint64_t v = r.varint();
+        tick += v >> 3;
+        const auto code = static_cast<std::uint8_t>(v & 7);
+        if (code > ReplayEvent::TOGGLE_BORDER) return false;
+        events.push_back({tick, code});
+    }
+
+    endTick = r.varint();
+    score   = static_cast<int>(r.varint());
+    length  = static_cast<int>(r.varint());
+    const std::uint8_t flags = r.byte();
+    died = (flags & 1) != 0;
+    won  = (flags & 2) != 0;
+    // Tablero jugable (la serpiente inicial ocupa 3 columnas) y de tamaño acotado: el fichero
+    // puede venir de fuera y Game reserva memoria proporcional a cols*rows.
+    return r.ok && cols >= 4 && rows >= 1
+        && static_cast<std::uint64_t>(cols) * static_cast<std::uint64_t>(rows) <= maxCells;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::vector<std::uint8_t> bytes;
+    encode(bytes);
+    std::ofstream f(path, std::ios::binary);
+    f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(f);
+}
+
+bool Replay::load(const std::string& path, std::uint64_t maxCells) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    return decode(bytes.data(), bytes.size(), maxCells);
+}
+
+ReplayCheck replayGame(const Replay& r, std::uint64_t maxTicks) {
+    Game g(r.cols, r.rows, r.seed);
+    g.setBorderMode(r.border);
+
+    // Sin giros la serpiente sigue recta: con muros choca y con wrap, pasado este plazo sin
+    // comer, el cuerpo entero está en una línea (fila o columna) que recorre sin fin.
+    const std::uint64_t settle = 2 * static_cast<std::uint64_t>(r.cols) * static_cast<std::uint64_t>(r.rows) + 4;
+    const std::uint64_t limit = std::min(r.endTick, maxTicks);
+    std::uint64_t quietFrom = 0; // último tick con evento o comida
+
+    std::size_t e = 0;
+    std::uint64_t t = 0, simulated = 0;
+    while (t < limit && !g.gameOver()) {
+        if (t - quietFrom > settle && g.queuedTurns() == 0) {
+            // Estado periódico: la posición se repite cada `line` ticks y el orden de la lista de
+            // celdas libres cada `line - longitud` (la celda que entra cede su hueco a la cola).
+            // Se salta un múltiplo del periodo conjunto hasta el próximo evento o el final.
+            const bool horizontal = g.dir() == Dir::Left || g.dir() == Dir::Right;
+            const std::uint64_t line = static_cast<std::uint64_t>(horizontal ? r.cols : r.rows);
+            const std::uint64_t len = g.snake().size(); // sigue viva, así que cabe en la línea
+            const std::uint64_t period = len < line ? std::lcm(line, line - len) : line;
+            const std::uint64_t until = e < r.events.size() ? std::min(r.events[e].tick, limit) : limit;
+            if (len <= line) t += (until - t) / period * period;
+            quietFrom = t;
+            if (t == limit) break;
+        }
+        for (; e < r.events.size() && r.events[e].tick == t; ++e) {
+            quietFrom = t;
+            const std::uint8_t code = r.events[e].code;
+            if (code == ReplayEvent::TOGGLE_BORDER) {
+                g.setBorderMode(g.borderModeMode() == Game::Border::Wrap ? Game::Border::Walls
+                                                                         : Game::Border::Wrap);
+            } else {
+                g.setPendingDir(static_cast<Dir>(code));
+            }
+        }
+        if (g.tick().foodChanged) quietFrom = t;
+        ++t;
+        ++simulated;
+    }
+    const bool cut = t < r.endTick && !g.gameOver();
+    return {t, g.score(), static_cast<int>(g.snake().size()), g.gameOver(), g.gameWon(), cut, simulated};
+}
+
+// ---------------- ReplayRecorder ----------------
+
+void ReplayRecorder::begin(const Game& g) {
+    rec.seed   = g.seed();
+    rec.cols   = g.cols();
+    rec.rows   = g.rows();
+    rec.border = g.borderModeMode();
+    rec.events.clear();
+    rec.endTick = 0;
+    rec.score = rec.length = 0;
+    rec.died = rec.won = false;
+    ticks   = 0;
+    lastDir = g.dir();
+    active  = true;
+}
+
+void ReplayRecorder::onTick(const Game& g) {
+    const TickDelta& d = g.lastDelta();
+    if (!active || !(d.moved || d.died)) return; // tick sin efecto: el juego ya había terminado
+    if (d.dir != lastDir) {
+        rec.events.push_back({ticks, static_cast<std::uint8_t>(d.dir)});
+        lastDir = d.dir;
+    }
+    ++ticks;
+}
+
+void ReplayRecorder::onBorderToggle() {
+    if (active) rec.events.push_back({ticks, ReplayEvent::TOGGLE_BORDER});
+}
+
+void ReplayRecorder::finish(const Game& g) {
+    rec.endTick = ticks;
+    rec.score   = g.score();
+    rec.length  = static_cast<int>(g.snake().size());
+    rec.died    = g.gameOver();
+    rec.won     = g.gameWon();
+    active = false;
+}
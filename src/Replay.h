@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Game.h"
+
+/**
+ * @brief Evento de una repetición: algo que pasó justo antes del tick `tick`.
+ *
+ * code 0..3 = nueva dirección (Dir), code 4 = alternar modo de borde.
+ */
+struct ReplayEvent {
+    std::uint64_t tick = 0;
+    std::uint8_t  code = 0;
+
+    static constexpr std::uint8_t TOGGLE_BORDER = 4;
+};
+
+/**
+ * @brief Partida grabada: semilla, tablero, eventos y resultado declarado.
+ *
+ * Formato binario (little-endian, enteros en varint LEB128):
+ *   "SNKR" | versión u8 | seed u64 | cols | rows | border u8 |
+ *   nº eventos | por evento ((tick - tick anterior) << 3 | code) |
+ *   endTick | score | length | flags u8 (bit0 = murió, bit1 = ganó)
+ *
+ * Solo se guardan los cambios de dirección, así que cuesta unos pocos bytes
+ * por giro y nada por tick.
+ */
+struct Replay {
+    std::uint64_t seed = 0;
+    int cols = 0;
+    int rows = 0;
+    Game::Border border = Game::Border::Wrap; ///< @brief Modo al empezar.
+    std::vector<ReplayEvent> events;
+
+    // --- Resultado declarado ---
+    std::uint64_t endTick = 0; ///< @brief Ticks jugados (incluye el de la muerte).
+    int  score  = 0;
+    int  length = 0;
+    bool died   = false;
+    bool won    = false;
+
+    /// @brief Celdas máximas aceptadas al leer por defecto (256 x 256, ~1 MB por Game).
+    static constexpr std::uint64_t MAX_CELLS = std::uint64_t{1} << 16;
+
+    /// @brief Serializa al formato binario.
+    void encode(std::vector<std::uint8_t>& out) const;
+    /// @brief Deserializa. @return false si los datos están truncados, no son una repetición
+    /// o el tablero pasa de maxCells (el fichero puede venir de fuera).
+    [[nodiscard]] bool decode(const std::uint8_t* data, std::size_t size, std::uint64_t maxCells = MAX_CELLS);
+
+    /// @brief Escribe a disco. @return false si falla la escritura.
+    [[nodiscard]] bool save(const std::string& path) const;
+    /// @brief Lee de disco. @return false si falla la lectura o el formato.
+    [[nodiscard]] bool load(const std::string& path, std::uint64_t maxCells = MAX_CELLS);
+};
+
+/**
+ * @brief Resultado de re-ejecutar una repetición con las reglas de Game.
+ */
+struct ReplayCheck {
+    std::uint64_t endTick = 0; ///< @brief Ticks ejecutados.
+    int  score  = 0;
+    int  length = 0;
+    bool died   = false;
+    bool won    = false;
+    bool cut    = false; ///< @brief Parada antes de r.endTick por maxTicks.
+    std::uint64_t simulated = 0; ///< @brief Ticks simulados de verdad (endTick sin los saltados).
+
+    /// @brief ¿Coincide con el resultado declarado en r?
+    bool matches(const Replay& r) const noexcept {
+        return endTick == r.endTick && score == r.score && length == r.length
+            && died == r.died && won == r.won;
+    }
+};
+
+/**
+ * @brief Re-ejecuta r sobre un Game nuevo, sin ventana ni GL.
+ *
+ * Aplica los eventos antes de su tick y avanza hasta r.endTick ticks, hasta
+ * que el juego termine o hasta maxTicks, lo que llegue antes. endTick viene
+ * del fichero y puede ser enorme: cuando la serpiente lleva tiempo sin giros
+ * ni comida solo da vueltas a una línea, y esas vueltas se saltan por
+ * periodos enteros en vez de simularse.
+ */
+ReplayCheck replayGame(const Replay& r, std::uint64_t maxTicks = UINT64_MAX);
+
+/**
+ * @brief Graba una partida observando Game entre ticks.
+ *
+ * Uso: begin() tras reset, onTick() tras cada tick, onBorderToggle() al
+ * cambiar el modo, finish() al terminar. onTick() solo compara la dirección
+ * aplicada con la anterior: O(1) y sin asignaciones salvo al añadir un giro.
+ */
+class ReplayRecorder {
+public:
+    /// @brief Empieza una grabación del episodio actual de g (recién reiniciado).
+    void begin(const Game& g);
+    /// @brief Registra el tick que acaba de ejecutar g.
+    void onTick(const Game& g);
+    /// @brief Registra un cambio de modo de borde (antes del próximo tick).
+    void onBorderToggle();
+    /// @brief Cierra la grabación con el resultado actual de g.
+    void finish(const Game& g);
+
+    /// @brief ¿Hay una grabación abierta?
+    bool recording() const noexcept { return active; }
+    /// @brief Repetición grabada (completa tras finish()).
+    const Replay& replay() const noexcept { return rec; }
+
+private:
+    Replay rec;
+    std::uint64_t ticks = 0; ///< @brief Ticks observados en este episodio.
+    Dir lastDir{};           ///< @brief Dirección aplicada en el último tick.
+    bool active = false;
+};
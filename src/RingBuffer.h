@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Cola circular de capacidad fija, reservada una sola vez.
+ *
+ * Semántica de deque restringida a lo que usa la serpiente: push_back en la
+ * cabeza y pop_front en la cola. No hay memoria dinámica tras el constructor,
+ * y el contenido vive en como mucho dos tramos contiguos
+ * (firstSegment() / secondSegment()).
+ */
+template <class T>
+class RingBuffer {
+public:
+    /// @brief Iterador de solo lectura en orden lógico (front -> back).
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        const_iterator() noexcept = default;
+        const_iterator(const RingBuffer* rb, std::size_t i) noexcept : ring(rb), pos(i) {}
+
+        reference operator*()  const noexcept { return (*ring)[pos]; }
+        pointer   operator->() const noexcept { return &(*ring)[pos]; }
+        const_iterator& operator++() noexcept { ++pos; return *this; }
+        const_iterator  operator++(int) noexcept { auto t = *this; ++pos; return t; }
+        bool operator==(const const_iterator& o) const noexcept { return pos == o.pos; }
+
+    private:
+        const RingBuffer* ring = nullptr;
+        std::size_t pos = 0;
+    };
+
+    /// @brief Reserva capacity elementos (capacity > 0).
+    explicit RingBuffer(std::size_t capacity) : buf(capacity) {}
+
+    // --- Consultas (O(1)) ---
+    std::size_t size()     const noexcept { return count; }
+    std::size_t capacity() const noexcept { return buf.size(); }
+    bool        empty()    const noexcept { return count == 0; }
+    bool        full()     const noexcept { return count == buf.size(); }
+
+    /// @brief Elemento lógico i (0 = front()).
+    const T& operator[](std::size_t i) const noexcept { return buf[physical(i)]; }
+    const T& front() const noexcept { return buf[head]; }
+    const T& back()  const noexcept { return buf[physical(count - 1)]; }
+
+    // --- Modificación (O(1), sin asignaciones) ---
+    /// @brief Añade al final. Precondición: !full().
+    void push_back(const T& v) noexcept {
+        buf[physical(count)] = v;
+        ++count;
+    }
+    /// @brief Retira del frente. Precondición: !empty().
+    void pop_front() noexcept {
+        if (++head == buf.size()) head = 0;
+        --count;
+    }
+    /// @brief Vacía sin liberar memoria.
+    void clear() noexcept { head = count = 0; }
+
+    // --- Vistas de iteración ---
+    const_iterator begin() const noexcept { return {this, 0}; }
+    const_iterator end()   const noexcept { return {this, count}; }
+
+    /// @brief Tramos contiguos en orden lógico: [front..] y el resto tras dar la vuelta.
+    std::span<const T> firstSegment() const noexcept {
+        const std::size_t n = (head + count <= buf.size()) ? count : buf.size() - head;
+        return {buf.data() + head, n};
+    }
+    std::span<const T> secondSegment() const noexcept {
+        const std::size_t n = count - firstSegment().size();
+        return {buf.data(), n};
+    }
+
+private:
+    std::vector<T> buf;     ///< @brief Almacenamiento fijo.
+    std::size_t head  = 0;  ///< @brief Posición física de front().
+    std::size_t count = 0;  ///< @brief Elementos vivos.
+
+    /// @brief Posición física del elemento lógico i (i < capacity).
+    std::size_t physical(std::size_t i) const noexcept {
+        const std::size_t p = head + i;
+        return p >= buf.size() ? p - buf.size() : p;
+    }
+};
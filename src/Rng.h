@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Generador pseudoaleatorio xoshiro256** con estado propio (32 bytes).
+ *
+ * Rápido, sin estado global y reproducible a partir de una semilla de 64 bits
+ * (expandida con splitmix64). Cada instancia es independiente: no hay
+ * contención entre hilos si cada uno usa la suya.
+ */
+class Rng {
+public:
+    /// @brief Construye y siembra el generador.
+    explicit Rng(std::uint64_t seed = 0) noexcept { reseed(seed); }
+
+    /// @brief Reinicia el estado a partir de una semilla.
+    void reseed(std::uint64_t seed) noexcept {
+        for (auto& w : s) w = splitmix64(seed);
+    }
+
+    /// @brief Siguiente valor uniforme de 64 bits.
+    std::uint64_t next() noexcept {
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    /// @brief Entero uniforme en [0, n) por multiplicación (n > 0).
+    std::uint32_t below(std::uint32_t n) noexcept {
+        return static_cast<std::uint32_t>(((next() >> 32) * n) >> 32);
+    }
+
+    /// @brief Avanza 2^128 pasos: separa flujos no solapados (uno por hilo) desde una misma semilla.
+    void jump() noexcept {
+        static constexpr std::uint64_t J[4] = {
+            0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+            0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+        std::uint64_t t[4]{};
+        for (const std::uint64_t j : J) {
+            for (int b = 0; b < 64; ++b) {
+                if (j & (std::uint64_t{1} << b)) for (int k = 0; k < 4; ++k) t[k] ^= s[k];
+                next();
+            }
+        }
+        for (int k = 0; k < 4; ++k) s[k] = t[k];
+    }
+
+    /// @brief Paso de splitmix64: avanza x y devuelve un valor mezclado.
+    static std::uint64_t splitmix64(std::uint64_t& x) noexcept {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    std::uint64_t s[4]{}; ///< @brief Estado xoshiro256.
+
+    static std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Game.h"
+
+/**
+ * @brief Ritmo de la simulación respecto al tiempo real.
+ */
+enum class SimSpeed : std::uint8_t {
+    Normal,      ///< @brief Un tick por plazo (frecuencia de SpeedCurve).
+    Turbo,       ///< @brief K ticks por frame; solo se dibuja el último estado.
+    FastForward  ///< @brief Tantos ticks como quepan en un frame.
+};
+
+/**
+ * @brief Copia inmutable del tablero que la simulación publica para el render.
+ */
+struct BoardSnapshot {
+    std::vector<Cell> body;   ///< @brief Cola -> cabeza (capacidad CxR reservada).
+    Cell food{};              ///< @brief Comida.
+    int  cols = 0;            ///< @brief Columnas.
+    int  rows = 0;            ///< @brief Filas.
+    int  score = 0;           ///< @brief Puntuación.
+    bool over = false;        ///< @brief Fin de juego.
+    bool won  = false;        ///< @brief Tablero completo.
+    Game::Border border = Game::Border::Wrap; ///< @brief Modo de borde.
+    bool moved = false;       ///< @brief El último tick movió la cabeza (hay tramo que interpolar).
+    Cell prevTail{};          ///< @brief Cola antes del último tick (= body.front() si creció).
+    std::int64_t tickNs = 0;  ///< @brief Instante (steady_clock, ns) en que tocaba el último tick.
+    std::int64_t tickIntervalNs = 1; ///< @brief ns reales hasta el siguiente tick (lo fija quien publica).
+    std::uint64_t version = 0; ///< @brief Nº de publicación (lo fija quien publica).
+    std::uint64_t caughtUpTicks = 0; ///< @brief Ticks de recuperación acumulados (lo fija quien publica).
+    std::uint64_t droppedTicks  = 0; ///< @brief Ticks descartados acumulados (lo fija quien publica).
+    SimSpeed speed = SimSpeed::Normal; ///< @brief Ritmo actual (lo fija quien publica).
+    double ticksPerSecond = 0.0;      ///< @brief Ticks/s medidos en turbo (lo fija quien publica).
+    bool autopilot = false;           ///< @brief Piloto automático activo (lo fija quien publica).
+
+    /// @brief Snapshot vacío con memoria para un tablero cols x rows.
+    static BoardSnapshot withCapacity(int cols, int rows) {
+        BoardSnapshot s;
+        s.body.reserve(static_cast<std::size_t>(cols) * rows);
+        return s;
+    }
+
+    /// @brief Copia el estado de g (sin asignaciones si la capacidad basta).
+    void capture(const Game& g) {
+        const auto& s = g.snake();
+        body.clear();
+        for (const auto seg : {s.firstSegment(), s.secondSegment()})
+            body.insert(body.end(), seg.begin(), seg.end());
+        food   = g.foodCell();
+        cols   = g.cols();
+        rows   = g.rows();
+        score  = g.score();
+        over   = g.gameOver();
+        won    = g.gameWon();
+        border = g.borderModeMode();
+
+        const TickDelta& d = g.lastDelta();
+        moved    = d.moved && body.size() >= 2;
+        prevTail = d.tailRemoved ? d.tail : body.front();
+    }
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <algorithm> // min, max
+#include <cmath>     // llround
+#include <cstdint>
+
+/**
+ * @brief Frecuencia de ticks en función de la puntuación.
+ *
+ * Cada pointsPerLevel puntos se sube un nivel y se suman hzPerLevel Hz a
+ * baseHz, sin pasar de maxHz. Con pointsPerLevel = 0 la frecuencia es fija.
+ */
+struct SpeedCurve {
+    double baseHz = 12.0;     ///< @brief Frecuencia con puntuación 0.
+    int pointsPerLevel = 0;   ///< @brief Puntos por nivel (0 = sin curva).
+    double hzPerLevel = 1.0;  ///< @brief Hz que suma cada nivel.
+    double maxHz = 30.0;      ///< @brief Tope de la curva.
+
+    /// @brief Ticks por segundo con la puntuación dada.
+    double hz(int score) const noexcept {
+        if (pointsPerLevel <= 0) return baseHz;
+        const double leveled = baseHz + (score / pointsPerLevel) * hzPerLevel;
+        return std::max(baseHz, std::min(leveled, maxHz));
+    }
+
+    /// @brief Intervalo entre ticks en ns (entero: los plazos se acumulan sin deriva).
+    std::int64_t intervalNs(int score) const noexcept {
+        return static_cast<std::int64_t>(std::llround(1e9 / hz(score)));
+    }
+};
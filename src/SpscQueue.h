@@ -0,0 +1,37 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Cola acotada sin locks de un productor y un consumidor.
+ *
+ * N debe ser potencia de dos. push() falla (sin bloquear) si está llena.
+ */
+template <class T, std::size_t N>
+class SpscQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N debe ser potencia de dos");
+public:
+    /// @brief Productor: encola v. @return false si la cola está llena.
+    bool push(const T& v) noexcept {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == N) return false;
+        buf[t & (N - 1)] = v;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Consumidor: desencola en out. @return false si la cola está vacía.
+    bool pop(T& out) noexcept {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        out = buf[h & (N - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, N> buf{};
+    alignas(64) std::atomic<std::size_t> head{0}; ///< @brief Siguiente a leer (consumidor).
+    alignas(64) std::atomic<std::size_t> tail{0}; ///< @brief Siguiente a escribir (productor).
+};
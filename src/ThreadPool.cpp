@@ -0,0 +1,90 @@
+#include "ThreadPool.h"
+
+namespace {
+    // Índice del trabajador que ejecuta el hilo actual (-1 fuera del pool).
+    thread_local int tlsWorker = -1;
+    thread_local const void* tlsPool = nullptr;
+} // namespace
+
+ThreadPool::ThreadPool(unsigned n) {
+    if (n == 0) n = std::thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    queues.reserve(n);
+    for (unsigned i = 0; i < n; ++i) queues.push_back(std::make_unique<Queue>());
+    threads.reserve(n);
+    for (unsigned i = 0; i < n; ++i) threads.emplace_back([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lk(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+void ThreadPool::submit(Task task) {
+    const unsigned q = (tlsPool == this)
+                     ? static_cast<unsigned>(tlsWorker)
+                     : nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lk(queues[q]->m);
+        queues[q]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    {
+        // Tomar el mutex evita perder el aviso entre la comprobación y el wait del trabajador.
+        std::lock_guard<std::mutex> lk(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lk(sleepMutex);
+    idle.wait(lk, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+bool ThreadPool::popLocal(unsigned self, Task& out) {
+    Queue& q = *queues[self];
+    std::lock_guard<std::mutex> lk(q.m);
+    if (q.tasks.empty()) return false;
+    out = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned self, Task& out) {
+    const unsigned n = size();
+    for (unsigned k = 1; k < n; ++k) {
+        Queue& q = *queues[(self + k) % n];
+        std::lock_guard<std::mutex> lk(q.m);
+        if (q.tasks.empty()) continue;
+        out = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned self) {
+    tlsWorker = static_cast<int>(self);
+    tlsPool = this;
+    for (;;) {
+        Task task;
+        if (popLocal(self, task) || steal(self, task)) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task(self);
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lk(sleepMutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lk(sleepMutex);
+        wake.wait(lk, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
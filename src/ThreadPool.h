@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool de hilos con una cola por trabajador y robo de tareas.
+ *
+ * Cada trabajador saca de su propia cola por detrás (LIFO, caché caliente) y,
+ * si se queda sin trabajo, roba por delante de la cola de otro (FIFO, tareas
+ * más grandes y antiguas). Las tareas reciben el índice del trabajador que las
+ * ejecuta para que puedan usar estado por hilo (RNG, acumuladores) sin locks.
+ */
+class ThreadPool {
+public:
+    /// @brief Tarea: recibe el índice del trabajador [0, size()).
+    using Task = std::function<void(unsigned worker)>;
+
+    /// @brief Arranca threads trabajadores (0 = std::thread::hardware_concurrency()).
+    explicit ThreadPool(unsigned threads = 0);
+    /// @brief Espera a que se vacíen las colas y une los hilos.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Encola una tarea. Desde un trabajador va a su propia cola; desde fuera, reparto circular.
+    void submit(Task task);
+
+    /// @brief Bloquea hasta que todas las tareas encoladas hayan terminado.
+    void wait();
+
+    /// @brief Nº de trabajadores.
+    unsigned size() const noexcept { return static_cast<unsigned>(queues.size()); }
+
+private:
+    /// @brief Cola de un trabajador (alineada para no compartir línea de caché).
+    struct alignas(64) Queue {
+        std::mutex m;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::atomic<std::size_t> queued{0};   ///< @brief Tareas en colas, aún sin recoger.
+    std::atomic<std::size_t> pending{0};  ///< @brief Tareas encoladas y no terminadas.
+    std::atomic<unsigned> nextQueue{0};   ///< @brief Reparto circular desde fuera del pool.
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;         ///< @brief Avisa a trabajadores dormidos.
+    std::condition_variable idle;         ///< @brief Avisa a wait() cuando pending llega a 0.
+    bool stopping = false;
+
+    void workerLoop(unsigned self);
+    bool popLocal(unsigned self, Task& out);
+    bool steal(unsigned self, Task& out);
+};
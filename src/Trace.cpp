@@ -0,0 +1,136 @@
+#include "Trace.h"
+#include <algorithm> // max
+#include <chrono>
+#include <cstdio> // snprintf
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+namespace {
+    /**
+     * @brief Anillo de spans de un hilo. Un solo escritor (su hilo); dump() lo lee
+     * como un seqlock: copia, y descarta lo que el escritor pudo pisar mientras tanto.
+     */
+    struct Ring {
+        struct Slot {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<std::int64_t> beginNs{0};
+            std::atomic<std::int64_t> endNs{0};
+        };
+
+        int tid = 0;
+        std::atomic<const char*> threadName{nullptr};
+        std::atomic<std::uint64_t> floor{0};            ///< @brief Índices < floor se borraron con clear().
+        alignas(64) std::atomic<std::uint64_t> head{0}; ///< @brief Spans escritos desde el arranque.
+        Slot slots[RING_CAPACITY];
+    };
+
+    // Los anillos no se liberan nunca: un hilo terminado sigue saliendo en dump().
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    thread_local Ring* tlsRing = nullptr;
+
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    Ring& threadRing() {
+        if (!tlsRing) {
+            auto r = std::make_unique<Ring>();
+            std::lock_guard lk(registryMutex);
+            r->tid = static_cast<int>(rings.size()) + 1;
+            tlsRing = r.get();
+            rings.push_back(std::move(r));
+        }
+        return *tlsRing;
+    }
+
+    /// @brief Escribe ns como microsegundos con tres decimales (unidad de Chrome trace).
+    void writeMicros(std::ostream& f, std::int64_t ns) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%lld.%03lld", (long long)(ns / 1000), (long long)(ns % 1000));
+        f << buf;
+    }
+
+    struct Event {
+        const char* name;
+        std::int64_t beginNs, endNs;
+    };
+} // namespace
+
+namespace detail {
+    std::int64_t nowNs() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    void record(const char* name, std::int64_t beginNs, std::int64_t endNs) noexcept {
+        Ring& r = threadRing();
+        const std::uint64_t i = r.head.load(std::memory_order_relaxed);
+        // Pareja del fence de dump(): si lee algo de este span, verá head >= i.
+        std::atomic_thread_fence(std::memory_order_release);
+        Ring::Slot& s = r.slots[i & (RING_CAPACITY - 1)];
+        s.name.store(name, std::memory_order_relaxed);
+        s.beginNs.store(beginNs, std::memory_order_relaxed);
+        s.endNs.store(endNs, std::memory_order_relaxed);
+        r.head.store(i + 1, std::memory_order_release);
+    }
+} // namespace detail
+
+void setThreadName(const char* name) noexcept {
+    threadRing().threadName.store(name, std::memory_order_relaxed);
+}
+
+void clear() noexcept {
+    std::lock_guard lk(registryMutex);
+    for (auto& r : rings) r->floor.store(r->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+bool dump(const std::string& path) {
+    std::ofstream f(path);
+    if (!f) return false;
+    f << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    const auto sep = [&] { if (!first) f << ",\n"; first = false; };
+    std::vector<Event> events;
+    events.reserve(RING_CAPACITY);
+
+    std::lock_guard lk(registryMutex);
+    for (const auto& r : rings) {
+        const std::uint64_t h = r->head.load(std::memory_order_acquire);
+        const std::uint64_t lo = std::max(r->floor.load(std::memory_order_relaxed),
+                                          h > RING_CAPACITY ? h - RING_CAPACITY : 0);
+        events.clear();
+        for (std::uint64_t i = lo; i < h; ++i) {
+            const Ring::Slot& s = r->slots[i & (RING_CAPACITY - 1)];
+            events.push_back({s.name.load(std::memory_order_relaxed),
+                              s.beginNs.load(std::memory_order_relaxed),
+                              s.endNs.load(std::memory_order_relaxed)});
+        }
+        // El escritor puede haber pisado los más antiguos durante la copia: se descartan.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t h2 = r->head.load(std::memory_order_relaxed);
+        const std::uint64_t keepFrom = h2 >= RING_CAPACITY ? h2 - RING_CAPACITY + 1 : 0;
+
+        if (const char* tn = r->threadName.load(std::memory_order_relaxed)) {
+            sep();
+            f << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << r->tid
+              << ",\"args\":{\"name\":\"" << tn << "\"}}";
+        }
+        for (std::uint64_t i = lo; i < h; ++i) {
+            if (i < keepFrom) continue;
+            const Event& e = events[i - lo];
+            sep();
+            f << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << r->tid << ",\"ts\":";
+            writeMicros(f, e.beginNs);
+            f << ",\"dur\":";
+            writeMicros(f, e.endNs - e.beginNs);
+            f << '}';
+        }
+    }
+    f << "]}\n";
+    return static_cast<bool>(f);
+}
+
+} // namespace trace
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Trazas de tiempo por bloques (spans) en formato Chrome/Perfetto.
+ *
+ * Cada hilo escribe sus spans en su propio anillo circular: registrar uno no
+ * toma locks ni asigna (solo la primera vez que un hilo traza se reserva su
+ * anillo). Cuando el anillo se llena se sobrescriben los spans más antiguos.
+ * dump() puede llamarse desde cualquier hilo en cualquier momento y escribe
+ * los spans que siguen en los anillos como JSON de chrome://tracing / Perfetto.
+ *
+ * Con la traza compilada pero desactivada, un TRACE_SCOPE cuesta una lectura
+ * atómica relajada y un salto. Compilando sin SNAKE_TRACE desaparece del todo.
+ */
+namespace trace {
+
+/// @brief Spans que guarda cada hilo antes de sobrescribir los más antiguos.
+inline constexpr std::size_t RING_CAPACITY = std::size_t{1} << 14;
+
+namespace detail {
+    inline std::atomic<bool> enabled{false};
+    std::int64_t nowNs() noexcept;
+    void record(const char* name, std::int64_t beginNs, std::int64_t endNs) noexcept;
+} // namespace detail
+
+/// @brief ¿Se están registrando spans?
+inline bool enabled() noexcept { return detail::enabled.load(std::memory_order_relaxed); }
+/// @brief Activa o desactiva el registro (los spans ya guardados se conservan).
+inline void setEnabled(bool on) noexcept { detail::enabled.store(on, std::memory_order_relaxed); }
+
+/// @brief Nombre del hilo actual en la traza (literal o cadena que viva siempre).
+void setThreadName(const char* name) noexcept;
+
+/// @brief Descarta los spans guardados en todos los hilos.
+void clear() noexcept;
+
+/**
+ * @brief Escribe los spans guardados como JSON de Chrome trace.
+ * @return false si no se pudo escribir el fichero.
+ */
+[[nodiscard]] bool dump(const std::string& path);
+
+/**
+ * @brief Span RAII: mide desde su construcción hasta su destrucción.
+ *
+ * name debe ser un literal (se guarda el puntero, no una copia).
+ */
+class Scope {
+public:
+    explicit Scope(const char* n) noexcept
+        : name(enabled() ? n : nullptr), beginNs(name ? detail::nowNs() : 0) {}
+    ~Scope() {
+        if (name) detail::record(name, beginNs, detail::nowNs());
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name;
+    std::int64_t beginNs;
+};
+
+} // namespace trace
+
+#define SNAKE_TRACE_CAT2(a, b) a##b
+#define SNAKE_TRACE_CAT(a, b) SNAKE_TRACE_CAT2(a, b)
+
+/// @brief Traza el resto del bloque actual con el nombre dado (literal).
+#if SNAKE_TRACE
+#define TRACE_SCOPE(name) ::trace::Scope SNAKE_TRACE_CAT(traceScope_, __LINE__){name}
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,42 @@
+#include "TranspositionTable.h"
+#include <algorithm> // max
+#include <bit>       // bit_ceil
+
+TranspositionTable::TranspositionTable(std::size_t entries)
+    : mask(std::bit_ceil(std::max<std::size_t>(1, (entries + WAYS - 1) / WAYS)) - 1),
+      buckets(std::make_unique<Bucket[]>(mask + 1)) {}
+
+void TranspositionTable::store(std::uint64_t key, std::uint64_t data) noexcept {
+    Bucket& b = bucketOf(key);
+    Entry* slot = nullptr;
+    for (Entry& e : b.e) {
+        const std::uint64_t d = e.data.load(std::memory_order_relaxed);
+        const std::uint64_t c = e.check.load(std::memory_order_relaxed);
+        if ((c ^ d) == key) { slot = &e; break; }
+        if (!slot && c == 0 && d == 0) slot = &e;
+    }
+    if (!slot) slot = &b.e[key >> 62]; // los bits bajos ya eligieron el cubo
+    slot->data.store(data, std::memory_order_relaxed);
+    slot->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::probe(std::uint64_t key, std::uint64_t& data) const noexcept {
+    for (const Entry& e : bucketOf(key).e) {
+        const std::uint64_t d = e.data.load(std::memory_order_relaxed);
+        const std::uint64_t c = e.check.load(std::memory_order_relaxed);
+        if ((c ^ d) == key && (c | d) != 0) {
+            data = d;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::clear() noexcept {
+    for (std::size_t i = 0; i <= mask; ++i) {
+        for (Entry& e : buckets[i].e) {
+            e.check.store(0, std::memory_order_relaxed);
+            e.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Tabla de transposición de tamaño fijo compartida entre hilos, sin locks.
+ *
+ * Asocia un hash de 64 bits (p. ej. Game::hash()) a un dato de 64 bits que
+ * elige quien la usa. Cada entrada guarda el dato y (clave XOR dato) en dos
+ * atómicos relajados: una escritura a medias entre hilos no casa con ninguna
+ * clave y se lee como fallo, así que no hacen falta locks ni CAS.
+ *
+ * Los cubos tienen 4 entradas y ocupan una línea de caché. store() sobrescribe
+ * la entrada de la misma clave, si no una vacía y si no una elegida con bits
+ * altos de la clave (reemplazo siempre). Una clave 0 con dato 0 no se distingue
+ * de una entrada vacía.
+ */
+class TranspositionTable {
+public:
+    /// @brief Reserva al menos entries entradas (redondeado a potencia de 2, mínimo un cubo).
+    explicit TranspositionTable(std::size_t entries);
+
+    /// @brief Guarda data para key.
+    void store(std::uint64_t key, std::uint64_t data) noexcept;
+
+    /// @brief Busca key. @return ¿Estaba? En ese caso deja su dato en data.
+    bool probe(std::uint64_t key, std::uint64_t& data) const noexcept;
+
+    /// @brief Vacía la tabla (no debe haber otros hilos usándola).
+    void clear() noexcept;
+
+    /// @brief Nº de entradas.
+    std::size_t capacity() const noexcept { return (mask + 1) * WAYS; }
+
+private:
+    static constexpr std::size_t WAYS = 4;
+
+    struct Entry {
+        std::atomic<std::uint64_t> check{0}; ///< @brief key ^ data.
+        std::atomic<std::uint64_t> data{0};
+    };
+    struct alignas(64) Bucket {
+        Entry e[WAYS];
+    };
+
+    std::size_t mask; ///< @brief Cubos - 1.
+    std::unique_ptr<Bucket[]> buckets;
+
+    Bucket& bucketOf(std::uint64_t key) const noexcept { return buckets[key & mask]; }
+};
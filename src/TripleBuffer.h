@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+
+/**
+ * @brief Triple buffer sin locks para un escritor y un lector.
+ *
+ * El escritor rellena back() y lo publica; el lector toma el último publicado
+ * con consume() y lo lee en front(). Ninguno de los dos espera nunca al otro:
+ * si el lector va lento se pierden estados intermedios, nunca se bloquea al
+ * escritor, y front() siempre es un estado completo.
+ */
+template <class T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    /// @brief Construye cada hueco con make(): una copia no conservaría la memoria reservada.
+    template <std::invocable Make>
+    explicit TripleBuffer(Make make) : slots{make(), make(), make()} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- Escritor ---
+    /// @brief Hueco privado del escritor.
+    T& back() noexcept { return slots[backIdx]; }
+    /// @brief Publica back() y recupera como nuevo back() el hueco intermedio anterior.
+    void publish() noexcept {
+        backIdx = middle.exchange(static_cast<std::uint8_t>(backIdx | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    // --- Lector ---
+    /// @brief Si hay un estado nuevo lo pasa a front(). @return true si front() cambió.
+    bool consume() noexcept {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        frontIdx = middle.exchange(frontIdx, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    /// @brief Último estado consumido por el lector.
+    const T& front() const noexcept { return slots[frontIdx]; }
+
+private:
+    static constexpr std::uint8_t INDEX = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;
+
+    T slots[3];
+    std::uint8_t backIdx  = 0;            ///< @brief Solo lo toca el escritor.
+    alignas(64) std::atomic<std::uint8_t> middle{1}; ///< @brief Índice intermedio + bit FRESH.
+    alignas(64) std::uint8_t frontIdx = 2; ///< @brief Solo lo toca el lector.
+};
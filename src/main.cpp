@@ -1,10 +1,63 @@
+#include <cstdio>  // sscanf
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include "App.h"
 
 /**
  * @brief Punto de entrada. Crea la aplicación, la inicializa y ejecuta.
+ *
+ * Opciones:
+ *   --record <dir>  Guarda una repetición (.snkr) por episodio en dir.
+ *   --trace <file>  Traza desde el arranque y la vuelca en file (F9 o al salir).
+ *   --hz F          Ticks por segundo con puntuación 0 (12 por defecto).
+ *   --speed-curve P,H,MAX  Cada P puntos suma H Hz, hasta MAX Hz.
+ *   --turbo K       Ticks por frame en modo turbo (tecla F).
+ *   --autopilot     Empieza con el piloto automático (tecla A).
+ *   --cycle         El piloto sigue un ciclo hamiltoniano con atajos (no muere) en vez de A*.
+ *   --max-catchup N Ticks máximos de recuperación por vuelta tras un parón
+ *                   (0 = automático: los que caben en ~100 ms, mínimo 5).
+ *   --time-scale F  Segundos de juego por segundo real (> 0; 0.5 = cámara lenta).
  */
-int main() {
-    App app(800, 600, "Snake OpenGL v1.0");
+int main(int argc, char** argv) {
+    AppConfig cfg;
+    bool ok = true;
+    for (int i = 1; i < argc && ok; ++i) {
+        const bool hasArg = i + 1 < argc;
+        if (std::strcmp(argv[i], "--record") == 0 && hasArg) {
+            cfg.recordDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--trace") == 0 && hasArg) {
+            cfg.traceFile = argv[++i];
+            cfg.traceAtStart = true;
+        } else if (std::strcmp(argv[i], "--hz") == 0 && hasArg) {
+            cfg.speed.baseHz = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--speed-curve") == 0 && hasArg) {
+            SpeedCurve& s = cfg.speed;
+            ok = std::sscanf(argv[++i], "%d,%lf,%lf", &s.pointsPerLevel, &s.hzPerLevel, &s.maxHz) == 3;
+        } else if (std::strcmp(argv[i], "--turbo") == 0 && hasArg) {
+            cfg.turboTicks = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--autopilot") == 0) {
+            cfg.autopilot = true;
+        } else if (std::strcmp(argv[i], "--cycle") == 0) {
+            cfg.cyclePilot = true;
+        } else if (std::strcmp(argv[i], "--max-catchup") == 0 && hasArg) {
+            cfg.maxCatchUp = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--time-scale") == 0 && hasArg) {
+            cfg.timeScale = std::atof(argv[++i]);
+        } else {
+            ok = false;
+        }
+    }
+    const SpeedCurve& s = cfg.speed;
+    ok = ok && s.baseHz > 0.0 && s.baseHz <= 1000.0 && s.pointsPerLevel >= 0 && s.maxHz > 0.0 && s.maxHz <= 1000.0;
+    if (!ok || cfg.turboTicks < 1 || cfg.maxCatchUp < 0 || !(cfg.timeScale > 0.0)) {
+        std::cerr << "Uso: " << argv[0]
+                  << " [--record <dir>] [--trace <fichero>] [--hz F] [--speed-curve P,H,MAX]"
+                     " [--turbo K] [--autopilot] [--cycle] [--max-catchup N] [--time-scale F]\n";
+        return -1;
+    }
+
+    App app(800, 600, "Snake OpenGL v1.0", cfg);
     if (!app.init()) return -1;
     app.run();
     return 0;
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include "Bitboard.h"
+#include "Game.h"
+#include "TranspositionTable.h"
+
+/**
+ * @brief Microbenchmarks de los caminos calientes de Game.
+ *
+ * Mide tick, spawnFood, occupies, reset y el relleno por bits de SpaceProbe
+ * (área alcanzable desde la cabeza y bolsas) para varios tamaños de tablero y
+ * grados de llenado, y store/probe de una TranspositionTable de una entrada
+ * por celda. Cada línea de stdout es un objeto JSON con ns/op
+ * (media, mínimo y percentiles por muestra) y asignaciones por op.
+ *
+ * Uso: snake_bench [--max-side N] [--samples N]
+ */
+
+// ---------------- Contador de asignaciones ----------------
+namespace {
+    std::atomic<std::uint64_t> gAllocs{0};
+}
+
+void* operator new(std::size_t n) {
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc{};
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+/// @brief Acceso a internos de Game (declarado friend en Game.h).
+struct GameProbe {
+    static void spawnFood(Game& g) { g.spawnFood(); }
+};
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    struct Board { int cols, rows; };
+
+    /// @brief Ciclo hamiltoniano en serpentina (rows par): fila 0 a la derecha, filas
+    /// siguientes en zigzag sobre x >= 1 y vuelta por la columna 0.
+    std::vector<Cell> serpentine(int C, int R) {
+        std::vector<Cell> cyc;
+        cyc.reserve(static_cast<std::size_t>(C) * R);
+        for (int y = 0; y < R; ++y) {
+            if (y == 0)          for (int x = 0; x < C; ++x)  cyc.push_back({x, y});
+            else if (y % 2 == 1) for (int x = C - 1; x >= 1; --x) cyc.push_back({x, y});
+            else                 for (int x = 1; x < C; ++x)  cyc.push_back({x, y});
+        }
+        for (int y = R - 1; y >= 1; --y) cyc.push_back({0, y});
+        return cyc;
+    }
+
+    Dir step(const Cell& a, const Cell& b) {
+        if (b.x == a.x + 1) return Dir::Right;
+        if (b.x == a.x - 1) return Dir::Left;
+        return b.y > a.y ? Dir::Down : Dir::Up;
+    }
+
+    /// @brief Tablero con la serpiente tendida sobre el ciclo; la cabeza sigue el ciclo y nunca choca.
+    struct Fixture {
+        int C, R;
+        std::vector<Cell> cycle;
+        std::vector<int> order;   ///< @brief Celda -> posición en el ciclo.
+        std::vector<Dir> next;    ///< @brief Celda -> dirección hacia la siguiente del ciclo.
+        std::size_t length;
+        Game game;
+
+        Fixture(int cols, int rows, double fill)
+            : C(cols), R(rows), cycle(serpentine(cols, rows)),
+              order(cycle.size()), next(cycle.size()),
+              length(std::max<std::size_t>(3, static_cast<std::size_t>(fill * double(cycle.size())))),
+              game(cols, rows, 1) {
+            for (std::size_t i = 0; i < cycle.size(); ++i) {
+                const Cell& c = cycle[i];
+                order[c.y * C + c.x] = static_cast<int>(i);
+                next[c.y * C + c.x] = step(c, cycle[(i + 1) % cycle.size()]);
+            }
+            load();
+        }
+
+        void load() {
+            const std::span<const Cell> body(cycle.data(), std::min(length, cycle.size() - 1));
+            game.loadBody(body, step(body[body.size() - 2], body.back()));
+        }
+
+        Dir follow() const {
+            const Cell& h = game.snake().back();
+            return next[h.y * C + h.x];
+        }
+    };
+
+    struct Result {
+        std::vector<double> nsPerOp; ///< @brief Una entrada por muestra.
+        std::uint64_t ops = 0;
+        std::uint64_t allocs = 0;
+    };
+
+    /**
+     * @brief Ejecuta una muestra de calentamiento y luego samples muestras.
+     *
+     * prep() va fuera del cronómetro; run(k) intenta k ops y devuelve cuántas hizo
+     * (las muestras sin ops no cuentan).
+     */
+    template <class Prep, class Run>
+    Result measure(int samples, int opsPerSample, Prep prep, Run run) {
+        Result r;
+        r.nsPerOp.reserve(static_cast<std::size_t>(samples));
+        prep();
+        run(opsPerSample);
+        for (int s = 0; s < samples; ++s) {
+            prep();
+            const std::uint64_t a0 = gAllocs.load(std::memory_order_relaxed);
+            const auto t0 = clock::now();
+            const int done = run(opsPerSample);
+            const auto t1 = clock::now();
+            if (done <= 0) continue;
+            r.allocs += gAllocs.load(std::memory_order_relaxed) - a0;
+            r.ops += static_cast<std::uint64_t>(done);
+            r.nsPerOp.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / done);
+        }
+        return r;
+    }
+
+    void report(const char* op, const Board& b, double fill, Result r) {
+        if (r.nsPerOp.empty()) return;
+        std::sort(r.nsPerOp.begin(), r.nsPerOp.end());
+        const auto pct = [&](double p) {
+            const std::size_t i = static_cast<std::size_t>(p * double(r.nsPerOp.size() - 1) + 0.5);
+            return r.nsPerOp[i];
+        };
+        double sum = 0.0;
+        for (double v : r.nsPerOp) sum += v;
+        std::printf("{\"op\":\"%s\",\"cols\":%d,\"rows\":%d,\"fill\":%.2f,\"samples\":%zu,\"ops\":%llu,"
+                    "\"ns_per_op\":%.2f,\"min\":%.2f,\"p50\":%.2f,\"p90\":%.2f,\"p99\":%.2f,"
+                    "\"allocs_per_op\":%.4f}\n",
+                    op, b.cols, b.rows, fill, r.nsPerOp.size(), (unsigned long long)r.ops,
+                    sum / double(r.nsPerOp.size()), r.nsPerOp.front(), pct(0.50), pct(0.90), pct(0.99),
+                    double(r.allocs) / double(r.ops));
+        std::fflush(stdout);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxSide = 4096;
+    int samples = 200;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--max-side") == 0 && i + 1 < argc)    maxSide = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) samples = std::max(1, std::atoi(argv[++i]));
+        else {
+            std::fprintf(stderr, "Uso: %s [--max-side N] [--samples N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const Board boards[] = {{30, 20}, {64, 64}, {256, 256}, {1024, 1024}, {4096, 4096}};
+    const double fills[] = {0.01, 0.10, 0.50, 0.90, 0.99};
+
+    for (const Board& b : boards) {
+        if (b.cols > maxSide || b.rows > maxSide) continue;
+        const std::size_t cells = static_cast<std::size_t>(b.cols) * b.rows;
+        // Tableros grandes: menos muestras en las ops que recargan el tablero (O(cols*rows)).
+        const int heavySamples = std::max(5, static_cast<int>(std::min<std::size_t>(
+                                     std::size_t(samples), (std::size_t{1} << 24) / cells)));
+
+        for (double fill : fills) {
+            Fixture fx(b.cols, b.rows, fill);
+            std::fprintf(stderr, "%dx%d fill %.2f (longitud %zu)\n", b.cols, b.rows, fill, fx.game.snake().size());
+
+            // tick (+ setPendingDir siguiendo el ciclo). Se recarga si la partida terminó o si la
+            // serpiente creció más de un 1% del tablero, para mantener el llenado pedido.
+            const std::size_t drift = std::max<std::size_t>(1, cells / 100);
+            report("tick", b, fill, measure(samples, 1024,
+                [&] { if (fx.game.gameOver() || fx.game.snake().size() > fx.length + drift) fx.load(); },
+                [&](int k) {
+                    int i = 0;
+                    for (; i < k && !fx.game.gameOver(); ++i) {
+                        fx.game.setPendingDir(fx.follow());
+                        fx.game.tick();
+                    }
+                    return i;
+                }));
+
+            // spawnFood sobre el llenado actual (no cambia el cuerpo).
+            fx.load();
+            report("spawnFood", b, fill, measure(samples, 1024, [] {},
+                [&](int k) { for (int i = 0; i < k; ++i) GameProbe::spawnFood(fx.game); return k; }));
+
+            // occupies en celdas aleatorias precalculadas.
+            std::vector<Cell> probes(4096);
+            Rng rng(7);
+            for (auto& c : probes) c = {static_cast<int>(rng.below(b.cols)), static_cast<int>(rng.below(b.rows))};
+            volatile int sink = 0;
+            report("occupies", b, fill, measure(samples, 4096, [] {},
+                [&](int k) {
+                    int hits = 0;
+                    for (int i = 0; i < k; ++i) hits += fx.game.occupies(probes[i & 4095]) ? 1 : 0;
+                    sink = sink + hits;
+                    return k;
+                }));
+
+            // Tabla de transposición con una entrada por celda (una vez por tablero, no depende del llenado).
+            if (fill == fills[0]) {
+                TranspositionTable tt(cells);
+                std::vector<std::uint64_t> keys(4096);
+                for (auto& k : keys) k = rng.next();
+                report("ttStore", b, fill, measure(samples, 4096, [] {},
+                    [&](int k) { for (int i = 0; i < k; ++i) tt.store(keys[i & 4095], keys[i & 4095] >> 7); return k; }));
+                report("ttProbe", b, fill, measure(samples, 4096, [] {},
+                    [&](int k) {
+                        std::uint64_t data = 0;
+                        int hits = 0;
+                        for (int i = 0; i < k; ++i) hits += tt.probe(keys[i & 4095] ^ (i & 1), data) ? 1 : 0;
+                        sink = sink + hits;
+                        return k;
+                    }));
+            }
+
+            // Área alcanzable desde la cabeza (foto incluida) y recuento de bolsas sobre la foto.
+            SpaceProbe space(b.cols, b.rows);
+            report("floodFill", b, fill, measure(samples, 1, [] {},
+                [&](int) {
+                    space.load(fx.game);
+                    sink = sink + static_cast<int>(space.reachableAfter(fx.game, fx.follow()));
+                    return 1;
+                }));
+            report("pockets", b, fill, measure(heavySamples, 1, [] {},
+                [&](int) { sink = sink + static_cast<int>(space.pockets(fx.game.snake().size())); return 1; }));
+
+            // reset desde el llenado dado: una op por muestra, recarga fuera del cronómetro.
+            report("reset", b, fill, measure(heavySamples, 1, [&] { fx.load(); },
+                [&](int) { fx.game.reset(); return 1; }));
+        }
+    }
+    return 0;
+}
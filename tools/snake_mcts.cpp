@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Mcts.h"
+
+/**
+ * @brief Juega episodios completos con MctsAgent e imprime puntuación y ritmo
+ * de simulaciones (para comparar con otros controladores).
+ *
+ * Uso: snake_mcts [--episodes N] [--size CxR] [--budget-ms F] [--max-ticks N] [--seed N] [--wall] [-j hilos]
+ */
+namespace {
+    void usage(const char* argv0) {
+        std::fprintf(stderr, "Uso: %s [--episodes N] [--size CxR] [--budget-ms F] [--max-ticks N]"
+                             " [--seed N] [--wall] [-j hilos]\n", argv0);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    int episodes = 3;
+    int cols = 30, rows = 20;
+    double budgetMs = 10.0;
+    long maxTicks = 100000;
+    std::uint64_t seed = 1;
+    bool wall = false;
+    unsigned threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasArg = i + 1 < argc;
+        if (std::strcmp(argv[i], "--episodes") == 0 && hasArg)       episodes = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--budget-ms") == 0 && hasArg) budgetMs = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-ticks") == 0 && hasArg) maxTicks = std::atol(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasArg)      seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (std::strcmp(argv[i], "-j") == 0 && hasArg)          threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--wall") == 0)                wall = true;
+        else if (std::strcmp(argv[i], "--size") == 0 && hasArg) {
+            if (std::sscanf(argv[++i], "%dx%d", &cols, &rows) != 2) { usage(argv[0]); return 2; }
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (episodes <= 0 || cols < 4 || rows < 1 || !(budgetMs > 0.0) || maxTicks <= 0) {
+        std::fprintf(stderr, "Parámetros inválidos: hacen falta --episodes, --budget-ms y --max-ticks > 0"
+                             " y --size de al menos 4x1\n");
+        return 2;
+    }
+
+    ThreadPool pool(threads);
+    MctsConfig cfg;
+    cfg.budgetNs = static_cast<std::int64_t>(budgetMs * 1e6);
+    cfg.seed = seed;
+    MctsAgent agent(cols, rows, pool, cfg);
+    std::printf("MCTS %dx%d (%s), %.3g ms por jugada, %u hilos\n",
+                cols, rows, wall ? "muro" : "toroide", budgetMs, pool.size());
+
+    Game game(cols, rows, seed);
+    game.setBorderMode(wall ? Game::Border::Walls : Game::Border::Wrap);
+    double scoreSum = 0.0;
+    for (int e = 0; e < episodes; ++e) {
+        if (e > 0) game.reset();
+        long ticks = 0;
+        std::uint64_t rollouts = 0;
+        double seconds = 0.0;
+        while (!game.gameOver() && ticks < maxTicks) {
+            agent.drive(game);
+            game.tick();
+            ++ticks;
+            rollouts += agent.lastStats().rollouts;
+            seconds += agent.lastStats().seconds;
+        }
+        scoreSum += game.score();
+        std::printf("episodio %d: score %d longitud %zu ticks %ld%s | %.3g simulaciones/s\n",
+                    e + 1, game.score(), game.snake().size(), ticks,
+                    game.gameWon() ? " (victoria)" : game.gameOver() ? "" : " (tope de ticks)",
+                    seconds > 0.0 ? double(rollouts) / seconds : 0.0);
+        std::fflush(stdout);
+    }
+    std::printf("score medio %.2f\n", scoreSum / episodes);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "BatchRunner.h"
+
+/**
+ * @brief Simulador sin ventana: avanza un GameBatch en paralelo con la política
+ * aleatoria de BatchRunner e imprime las estadísticas de episodios.
+ *
+ * Uso: snake_sim [--boards N] [--size CxR] [--ticks N] [--seed N] [--wall] [-j hilos]
+ */
+namespace {
+    void usage(const char* argv0) {
+        std::fprintf(stderr, "Uso: %s [--boards N] [--size CxR] [--ticks N] [--seed N] [--wall] [-j hilos]\n", argv0);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t boards = 4096;
+    int cols = 30, rows = 20;
+    std::uint64_t ticks = 1000;
+    std::uint64_t seed = 1;
+    bool wall = false;
+    unsigned threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasArg = i + 1 < argc;
+        if (std::strcmp(argv[i], "--boards") == 0 && hasArg)     boards = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--ticks") == 0 && hasArg) ticks = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasArg)  seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (std::strcmp(argv[i], "-j") == 0 && hasArg)      threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--wall") == 0)            wall = true;
+        else if (std::strcmp(argv[i], "--size") == 0 && hasArg) {
+            if (std::sscanf(argv[++i], "%dx%d", &cols, &rows) != 2) { usage(argv[0]); return 2; }
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (boards == 0 || cols < 4 || rows < 1) {
+        std::fprintf(stderr, "Tablero inválido: hace falta --boards > 0 y --size de al menos 4x1\n");
+        return 2;
+    }
+
+    GameBatch batch(boards, cols, rows, seed);
+    batch.setBorderMode(wall ? Game::Border::Walls : Game::Border::Wrap);
+    ThreadPool pool(threads);
+    BatchRunner runner(batch, pool, seed);
+
+    const EpisodeStats st = runner.run(ticks);
+    std::printf("%zu tableros %dx%d (%s), %llu ticks por tablero, %u hilos\n",
+                boards, cols, rows, wall ? "muro" : "toroide", (unsigned long long)ticks, pool.size());
+    std::printf("episodios %llu (victorias %llu) | score medio %.2f max %d | longitud media %.2f max %d"
+                " | duración media %.1f max %d\n",
+                (unsigned long long)st.episodes, (unsigned long long)st.wins,
+                st.meanScore(), st.maxScore, st.meanLength(), st.maxLength,
+                st.meanEpisodeTicks(), st.maxEpisodeTicks);
+    std::printf("%llu ticks en %.3f s (%.3g ticks/s)\n",
+                (unsigned long long)st.ticks, st.seconds, st.ticksPerSecond());
+    return 0;
+}
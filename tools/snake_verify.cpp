@@ -0,0 +1,98 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Replay.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Verificador de repeticiones sin ventana.
+ *
+ * Re-ejecuta cada .snkr con el mismo Game que el juego y comprueba puntuación,
+ * longitud y tick de fin declarados. Sale con 0 si todas coinciden, 1 si alguna
+ * no coincide y 2 si alguna no se pudo leer. --max-ticks corta cada
+ * re-ejecución tras N ticks (la repetición cuenta entonces como distinta).
+ * --max-cells rechaza como ilegibles los tableros de más de N celdas (por
+ * defecto Replay::MAX_CELLS): cada hilo reserva memoria según el tablero.
+ *
+ * Uso: snake_verify [-j hilos] [-q] [--max-ticks N] [--max-cells N] fichero.snkr...
+ */
+namespace {
+    struct Outcome {
+        bool loaded = false;
+        bool ok = false;
+        Replay claimed;
+        ReplayCheck actual;
+    };
+
+    void usage(const char* argv0) {
+        std::fprintf(stderr, "Uso: %s [-j hilos] [-q] [--max-ticks N] [--max-cells N] fichero.snkr...\n", argv0);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    bool quiet = false;
+    std::uint64_t maxTicks = UINT64_MAX;
+    std::uint64_t maxCells = Replay::MAX_CELLS;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "-q") == 0)            quiet = true;
+        else if (std::strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc)
+            maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--max-cells") == 0 && i + 1 < argc)
+            maxCells = std::strtoull(argv[++i], nullptr, 10);
+        else if (argv[i][0] == '-')                          { usage(argv[0]); return 2; }
+        else                                                 files.emplace_back(argv[i]);
+    }
+    if (files.empty()) { usage(argv[0]); return 2; }
+
+    std::vector<Outcome> out(files.size());
+    std::atomic<std::uint64_t> ticks{0};
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(threads);
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            pool.submit([&, i](unsigned) {
+                Outcome& o = out[i];
+                o.loaded = o.claimed.load(files[i], maxCells);
+                if (!o.loaded) return;
+                o.actual = replayGame(o.claimed, maxTicks);
+                o.ok = o.actual.matches(o.claimed);
+                ticks.fetch_add(o.actual.simulated, std::memory_order_relaxed);
+            });
+        }
+        pool.wait();
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::size_t bad = 0, unreadable = 0;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const Outcome& o = out[i];
+        if (!o.loaded) {
+            ++unreadable;
+            std::printf("ERROR    %s: no se pudo leer\n", files[i].c_str());
+        } else if (!o.ok) {
+            ++bad;
+            std::printf("MISMATCH %s: declarado score=%d len=%d fin=%llu%s, real score=%d len=%d fin=%llu%s%s\n",
+                        files[i].c_str(),
+                        o.claimed.score, o.claimed.length, (unsigned long long)o.claimed.endTick,
+                        o.claimed.died ? " (muerte)" : "",
+                        o.actual.score, o.actual.length, (unsigned long long)o.actual.endTick,
+                        o.actual.died ? " (muerte)" : "", o.actual.cut ? " (cortada)" : "");
+        } else if (!quiet) {
+            std::printf("OK       %s: score=%d len=%d fin=%llu\n",
+                        files[i].c_str(), o.actual.score, o.actual.length, (unsigned long long)o.actual.endTick);
+        }
+    }
+
+    const auto total = ticks.load();
+    std::printf("%zu repeticiones, %zu OK, %zu distintas, %zu ilegibles | %llu ticks en %.3f s (%.3g ticks/s)\n",
+                files.size(), files.size() - bad - unreadable, bad, unreadable,
+                (unsigned long long)total, secs, secs > 0.0 ? (double)total / secs : 0.0);
+    return unreadable ? 2 : (bad ? 1 : 0);
+}